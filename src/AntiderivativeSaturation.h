@@ -0,0 +1,168 @@
+/*
+  ==============================================================================
+    VT-2R - EMU AUDIO
+    Antiderivative Anti-Aliasing
+
+    First-order ADAA tanh on SIMDRegister lanes: a cheaper alternative to
+    oversampling the saturator.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "SIMDVector.h"
+
+#include <type_traits>
+
+namespace VT2RDSP {
+
+//==============================================================================
+/**
+ * Saturator anti-aliasing (the "antialiasing" parameter).
+ *
+ * ADAA replaces tanh(x[n]) by its mean over the input range the signal
+ * crossed since the last sample, x[n-1] .. x[n], evaluated in closed form
+ * from the antiderivative of tanh:
+ *
+ *   F1(x) = log cosh x = |x| - ln2 + w,          w = log1p(exp(-2|x|))
+ *
+ * The |x| part is handled algebraically, so only the bounded w is
+ * differenced numerically. Where consecutive inputs are closer than the
+ * tolerance the quotient is ill-conditioned and an Euler-Maclaurin
+ * expansion (O(delta^4)) is used instead.
+ *
+ * Side effects, also those of a linear filter for small signals: half a
+ * sample of delay (not compensated in the dry path) and the response
+ * (1 + z^-1) / 2 (-2.0 dB at 10 kHz / 48 kHz, -0.5 dB at 10 kHz / 96 kHz).
+ *
+ * There is no 2nd order: it needs double lanes (the second difference
+ * divides rounding by two input steps) and cost 5.2-5.6x the plain wet
+ * path for -26 dBc, where 2x oversampling costs 3.1x for -36 dBc (see
+ * DSP_DESIGN.md).
+ */
+enum class Antialiasing { Off = 0, FirstOrder };
+
+//==============================================================================
+/**
+ * tanh(x) and w = log1p(exp(-2|x|)) of one lane vector from a single
+ * range-reduced exp.
+ *
+ * ADAA divides differences of these values by small input steps, so they
+ * are accurate to the lane precision (degree 6 / 12 exp, 7 / 17 term
+ * log1p) rather than sharing the float constants of TanhPolynomial.
+ */
+template <typename SampleType> struct LogCoshTerms {
+  using V = SIMDRegister<SampleType>;
+
+  static constexpr bool kIsDouble = std::is_same_v<SampleType, double>;
+  static constexpr int kExpDegree = kIsDouble ? 12 : 6;
+  static constexpr int kLogTerms = kIsDouble ? 17 : 7;
+
+  // exp(-60) is still a normal float; tanh and w are exact beyond
+  static constexpr SampleType kMaxMagnitude = 30;
+
+  static constexpr SampleType kLog2e = SampleType(1.44269504088896340736);
+  static constexpr SampleType kLn2Hi =
+      kIsDouble ? SampleType(6.93147180369123816490e-1)
+                : SampleType(0.693145751953125f);
+  static constexpr SampleType kLn2Lo =
+      kIsDouble ? SampleType(1.90821492927058770002e-10)
+                : SampleType(1.42860682030941723212e-6f);
+
+  V tanh; // tanh(x)
+  V w;    // log1p(exp(-2|x|)) = log cosh(x) - |x| + ln2, in (0, ln2]
+
+  static LogCoshTerms evaluate(V x) {
+    const auto one = V::broadcast(SampleType(1));
+    const auto two = V::broadcast(SampleType(2));
+
+    // e = exp(-2|x|) = 2^n * exp(r), |r| <= ln2 / 2
+    const auto ax = V::min(V::abs(x), V::broadcast(kMaxMagnitude));
+    const auto y = V::broadcast(SampleType(-2)) * ax;
+    const auto n = V::round(y * V::broadcast(kLog2e));
+    const auto r = (y - n * V::broadcast(kLn2Hi)) - n * V::broadcast(kLn2Lo);
+
+    auto p = V::broadcast(inverseFactorial(kExpDegree));
+    for (int k = kExpDegree - 1; k >= 0; --k)
+      p = p * r + V::broadcast(inverseFactorial(k));
+    const auto e = V::ldexp(p, n);
+
+    // log1p(e) = 2 atanh(s), s = e / (2 + e) <= 1/3
+    const auto s = e / (two + e);
+    const auto s2 = s * s;
+    auto q = V::broadcast(SampleType(1) / SampleType(2 * kLogTerms - 1));
+    for (int k = kLogTerms - 2; k >= 0; --k)
+      q = q * s2 + V::broadcast(SampleType(1) / SampleType(2 * k + 1));
+
+    return {V::copySign((one - e) / (one + e), x), two * s * q};
+  }
+
+private:
+  static constexpr SampleType inverseFactorial(int k) {
+    SampleType f = 1;
+    for (int i = 2; i <= k; ++i)
+      f *= SampleType(i);
+    return SampleType(1) / f;
+  }
+};
+
+//==============================================================================
+/** First-order ADAA history, one channel per lane. Zero input at rest. */
+template <typename SampleType> struct ADAA1State {
+  using V = SIMDRegister<SampleType>;
+
+  V x1 = V::zero();
+  V tanh1 = V::zero();
+  V w1 = V::broadcast(SampleType(0.693147180559945309417)); // w(0) = ln2
+};
+
+/**
+ * First-order ADAA tanh in the lane precision:
+ *
+ *   y[n] = (F1(x[n]) - F1(x[n-1])) / (x[n] - x[n-1])
+ *
+ * Stateful: the history lives in the referenced ADAA1State (one per lane
+ * group), so one instance serves one lane group for as long as it is
+ * used. Only the SIMDRegister overload exists - the kernels are the only
+ * callers.
+ */
+template <typename SampleType> struct TanhADAA1 {
+  using V = SIMDRegister<SampleType>;
+
+  // Balances the rounding of the w difference (~ulp / delta) against the
+  // fallback's O(delta^4) error: both stay below ~1e-6 in float
+  static constexpr SampleType kTolerance =
+      std::is_same_v<SampleType, double> ? SampleType(1.0e-3)
+                                         : SampleType(0.05f);
+
+  ADAA1State<SampleType> &state;
+
+  V operator()(V x) const {
+    const auto terms = LogCoshTerms<SampleType>::evaluate(x);
+    const auto zero = V::zero();
+    const auto x1 = state.x1;
+    const auto t0 = terms.tanh;
+    const auto t1 = state.tanh1;
+    const auto delta = x - x1;
+
+    // (|x| - |x1|) / delta is exactly sgn(x) while the sign holds
+    const auto magnitude =
+        V::selectLess(x * x1, zero, (V::abs(x) - V::abs(x1)) / delta,
+                      V::copySign(V::broadcast(SampleType(1)), x + x1));
+    const auto average = magnitude + (terms.w - state.w1) / delta;
+
+    // Trapezoid with end correction: mean of tanh over [x1, x]
+    const auto nearby = (t0 + t1) * V::broadcast(SampleType(0.5)) +
+                        delta * (t0 * t0 - t1 * t1) *
+                            V::broadcast(SampleType(1) / SampleType(12));
+
+    state.x1 = x;
+    state.tanh1 = t0;
+    state.w1 = terms.w;
+
+    return V::selectLess(V::abs(delta), V::broadcast(kTolerance), nearby,
+                         average);
+  }
+};
+
+} // namespace VT2RDSP
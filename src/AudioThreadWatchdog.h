@@ -0,0 +1,176 @@
+/*
+  ==============================================================================
+    VT-2R - EMU AUDIO
+    Audio Thread Watchdog
+
+    Per-block CPU load relative to the realtime budget, as a lock-free
+    histogram, plus (instrumented builds, VT2R_RT_WATCHDOG=1) counts of
+    heap operations and blocking calls made inside the audio callback.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#ifndef VT2R_RT_WATCHDOG
+#define VT2R_RT_WATCHDOG 0
+#endif
+
+namespace VT2RDSP {
+
+//==============================================================================
+/**
+ * Real-time safety violations (RealtimeSafety.cpp).
+ *
+ * With VT2R_RT_WATCHDOG=1 the global operator new/delete are replaced and,
+ * on Linux, pthread_mutex_lock / sem_wait / nanosleep / usleep are
+ * interposed; each call made between enterAudioCallback() and
+ * leaveAudioCallback() on the same thread is counted. Counts are
+ * process-wide. The replacements take effect where the binary's own
+ * symbols are bound first (Standalone, console tools); a host loading the
+ * plugin may bind them elsewhere. Without the flag everything here
+ * compiles to nothing.
+ */
+namespace RealtimeSafety {
+constexpr bool kInstrumented = VT2R_RT_WATCHDOG != 0;
+
+#if VT2R_RT_WATCHDOG
+void enterAudioCallback();
+void leaveAudioCallback();
+uint32_t getHeapOperationCount();
+uint32_t getBlockingCallCount();
+#else
+inline void enterAudioCallback() {}
+inline void leaveAudioCallback() {}
+inline uint32_t getHeapOperationCount() { return 0; }
+inline uint32_t getBlockingCallCount() { return 0; }
+#endif
+} // namespace RealtimeSafety
+
+//==============================================================================
+/**
+ * Block timing histogram.
+ *
+ * Load = processing time / block duration (1.0 = the whole realtime
+ * budget). Written by the audio thread only (single writer, relaxed
+ * atomics), read by any other thread through getSnapshot().
+ */
+class AudioThreadWatchdog {
+public:
+  static constexpr int kNumBins = 40;
+  static constexpr double kBinWidth = 0.05; // 5 % of the budget per bin;
+                                            // the last bin is >= 195 %
+
+  struct Snapshot {
+    std::array<uint32_t, kNumBins> bins{};
+    uint64_t numBlocks = 0;
+    uint32_t numOverruns = 0; // blocks over 100 % of the budget
+    double meanLoad = 0.0;
+    double worstLoad = 0.0;
+    uint32_t heapOperations = 0; // instrumented builds only
+    uint32_t blockingCalls = 0;  // instrumented builds only
+  };
+
+  /** Clears the statistics. Not concurrently with an audio block. */
+  void reset() {
+    for (auto &bin : bins)
+      bin.store(0, std::memory_order_relaxed);
+    numBlocks.store(0, std::memory_order_relaxed);
+    numOverruns.store(0, std::memory_order_relaxed);
+    loadSum.store(0.0, std::memory_order_relaxed);
+    worstLoad.store(0.0, std::memory_order_relaxed);
+    heapOperationsAtReset.store(RealtimeSafety::getHeapOperationCount(),
+                                std::memory_order_relaxed);
+    blockingCallsAtReset.store(RealtimeSafety::getBlockingCallCount(),
+                               std::memory_order_relaxed);
+  }
+
+  /** Audio thread: one processed block. */
+  void addBlock(double seconds, int numSamples, double sampleRate) {
+    if (numSamples <= 0 || sampleRate <= 0.0)
+      return;
+
+    const double load = seconds * sampleRate / double(numSamples);
+    const int bin = load >= kBinWidth * kNumBins ? kNumBins - 1
+                                                 : int(load / kBinWidth);
+
+    bins[size_t(bin)].fetch_add(1, std::memory_order_relaxed);
+    numBlocks.fetch_add(1, std::memory_order_relaxed);
+    if (load > 1.0)
+      numOverruns.fetch_add(1, std::memory_order_relaxed);
+
+    // Single writer: load + store needs no compare-exchange
+    loadSum.store(loadSum.load(std::memory_order_relaxed) + load,
+                  std::memory_order_relaxed);
+    if (load > worstLoad.load(std::memory_order_relaxed))
+      worstLoad.store(load, std::memory_order_relaxed);
+  }
+
+  Snapshot getSnapshot() const {
+    Snapshot snapshot;
+    for (size_t i = 0; i < bins.size(); ++i)
+      snapshot.bins[i] = bins[i].load(std::memory_order_relaxed);
+
+    snapshot.numBlocks = numBlocks.load(std::memory_order_relaxed);
+    snapshot.numOverruns = numOverruns.load(std::memory_order_relaxed);
+    snapshot.worstLoad = worstLoad.load(std::memory_order_relaxed);
+    if (snapshot.numBlocks > 0)
+      snapshot.meanLoad = loadSum.load(std::memory_order_relaxed) /
+                          double(snapshot.numBlocks);
+
+    snapshot.heapOperations =
+        RealtimeSafety::getHeapOperationCount() -
+        heapOperationsAtReset.load(std::memory_order_relaxed);
+    snapshot.blockingCalls =
+        RealtimeSafety::getBlockingCallCount() -
+        blockingCallsAtReset.load(std::memory_order_relaxed);
+    return snapshot;
+  }
+
+  /**
+   * Times the enclosing processBlock and marks it as the audio callback
+   * for the real-time safety counters.
+   */
+  class BlockScope {
+  public:
+    BlockScope(AudioThreadWatchdog &owner, int numSamples, double sampleRate)
+        : watchdog(owner), blockSamples(numSamples), rate(sampleRate),
+          start(Clock::now()) {
+      RealtimeSafety::enterAudioCallback();
+    }
+
+    ~BlockScope() {
+      RealtimeSafety::leaveAudioCallback();
+      const std::chrono::duration<double> elapsed = Clock::now() - start;
+      watchdog.addBlock(elapsed.count(), blockSamples, rate);
+    }
+
+    BlockScope(const BlockScope &) = delete;
+    BlockScope &operator=(const BlockScope &) = delete;
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    AudioThreadWatchdog &watchdog;
+    const int blockSamples;
+    const double rate;
+    const Clock::time_point start;
+  };
+
+private:
+  std::array<std::atomic<uint32_t>, kNumBins> bins{};
+  std::atomic<uint64_t> numBlocks{0};
+  std::atomic<uint32_t> numOverruns{0};
+  std::atomic<double> loadSum{0.0};
+  std::atomic<double> worstLoad{0.0};
+
+  // Process-wide counters at the last reset()
+  std::atomic<uint32_t> heapOperationsAtReset{0};
+  std::atomic<uint32_t> blockingCallsAtReset{0};
+};
+
+} // namespace VT2RDSP
@@ -0,0 +1,203 @@
+/*
+  ==============================================================================
+    VT-2R - EMU AUDIO
+    Baked Image
+
+    Editor artwork as decoded, premultiplied, zlib compressed pixels
+    (written at build time).
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_graphics/juce_graphics.h>
+
+namespace VT2RAssets {
+
+//==============================================================================
+/**
+ * Layout of one bake (little endian):
+ *
+ *   offset 0   uint32  kMagic ("VT2I")
+ *   offset 4   uint16  format version
+ *   offset 6   uint16  display scale x 100 (100 = 1x, 150 = 1.5x ...)
+ *   offset 8   uint32  pixel width, pixel height
+ *   offset 16  uint32  logical width, logical height (component units)
+ *   offset 24  uint32  n, size of the compressed pixels
+ *   offset 28  n bytes: pixel width x pixel height x 4 bytes (B, G, R, A,
+ *              premultiplied, rows top to bottom, no padding), zlib
+ *              compressed
+ *
+ * The pixel bytes are the in-memory layout of a juce::Image::ARGB on little
+ * endian machines, so loading inflates straight into the image rows: no
+ * PNG unfiltering, no resampling, no premultiplication. zlib (juce_core)
+ * brings the pixels back to roughly PNG size in the binary. The header
+ * alone (readHeader) gives the sizes without touching the pixels.
+ *
+ * vt2r_bake_images writes one file per image from the PNG in resources/,
+ * holding its bakes for the display scales in VT2R_IMAGE_SCALES back to
+ * back (see CMakeLists.txt). Scales beyond the PNG's own resolution share
+ * one bake at that resolution: upscaled pixels would add size, not detail.
+ */
+constexpr juce::uint32 kMagic = 0x49325456; // "VT2I" when read as bytes
+constexpr int kVersion = 2;
+constexpr int kHeaderSize = 28;
+
+struct Header {
+  int width = 0, height = 0; // pixels = logical size x scale
+  int logicalWidth = 0, logicalHeight = 0;
+  float scale = 1.0f;
+  size_t size = 0; // bytes of this bake, header included (the next follows)
+};
+
+//==============================================================================
+namespace detail {
+inline juce::uint32 readUint(const juce::uint8 *source, int numBytes) {
+  juce::uint32 value = 0;
+  for (int i = 0; i < numBytes; ++i)
+    value |= juce::uint32(source[i]) << (8 * i);
+  return value;
+}
+
+inline void writeUint(juce::uint8 *dest, juce::uint32 value, int numBytes) {
+  for (int i = 0; i < numBytes; ++i)
+    dest[i] = juce::uint8(value >> (8 * i));
+}
+} // namespace detail
+
+/**
+ * Reads the header of the bake at data. False if it is not a bake of this
+ * version, or is truncated.
+ */
+inline bool readHeader(const void *data, size_t sizeInBytes, Header &header) {
+  const auto *bytes = static_cast<const juce::uint8 *>(data);
+
+  if (data == nullptr || sizeInBytes < size_t(kHeaderSize) ||
+      detail::readUint(bytes, 4) != kMagic ||
+      int(detail::readUint(bytes + 4, 2)) != kVersion)
+    return false;
+
+  Header h;
+  h.scale = float(detail::readUint(bytes + 6, 2)) / 100.0f;
+  h.width = int(detail::readUint(bytes + 8, 4));
+  h.height = int(detail::readUint(bytes + 12, 4));
+  h.logicalWidth = int(detail::readUint(bytes + 16, 4));
+  h.logicalHeight = int(detail::readUint(bytes + 20, 4));
+  h.size = size_t(kHeaderSize) + detail::readUint(bytes + 24, 4);
+
+  if (h.width <= 0 || h.height <= 0 || sizeInBytes < h.size)
+    return false;
+
+  header = h;
+  return true;
+}
+
+/** The pixels of the bake at data as an ARGB image (null if not valid). */
+inline juce::Image load(const void *data, size_t sizeInBytes) {
+  Header header;
+  if (!readHeader(data, sizeInBytes, header))
+    return {};
+
+  const int width = header.width;
+  const int height = header.height;
+  const int rowBytes = width * 4;
+
+  juce::MemoryInputStream compressed(
+      static_cast<const juce::uint8 *>(data) + kHeaderSize,
+      header.size - size_t(kHeaderSize), false);
+  juce::GZIPDecompressorInputStream pixels(
+      &compressed, false, juce::GZIPDecompressorInputStream::zlibFormat,
+      juce::int64(rowBytes) * height);
+
+  // Every pixel is written below: no clearing
+  juce::Image image(juce::Image::ARGB, width, height, false);
+  {
+    juce::Image::BitmapData bitmap(image, juce::Image::BitmapData::writeOnly);
+    std::vector<juce::uint8> row; // non-ARGB bitmaps only
+
+    for (int y = 0; y < height; ++y) {
+      auto *line = bitmap.getLinePointer(y);
+#if JUCE_LITTLE_ENDIAN
+      if (bitmap.pixelStride == 4) {
+        if (pixels.read(line, rowBytes) != rowBytes)
+          return {};
+        continue;
+      }
+#endif
+      row.resize(size_t(rowBytes));
+      if (pixels.read(row.data(), rowBytes) != rowBytes)
+        return {};
+
+      for (int x = 0; x < width; ++x) {
+        const auto *p = row.data() + 4 * x;
+        reinterpret_cast<juce::PixelARGB *>(line + x * bitmap.pixelStride)
+            ->setARGB(p[3], p[2], p[1], p[0]);
+      }
+    }
+  }
+
+  return image;
+}
+
+/**
+ * Resamples source to logicalWidth x scale pixels (height in proportion)
+ * and returns the bake (header + compressed pixels). Large reductions go
+ * through successive halvings, which keeps the high quality resampler from
+ * skipping pixels.
+ */
+inline juce::MemoryBlock bake(const juce::Image &source, int logicalWidth,
+                              float scale) {
+  const float aspect = float(source.getHeight()) / float(source.getWidth());
+  const int logicalHeight = juce::roundToInt(float(logicalWidth) * aspect);
+  const int width = juce::roundToInt(float(logicalWidth) * scale);
+  const int height = juce::roundToInt(float(logicalHeight) * scale);
+
+  auto image = source.convertedToFormat(juce::Image::ARGB);
+  while (image.getWidth() >= 2 * width && image.getHeight() >= 2 * height)
+    image = image.rescaled(image.getWidth() / 2, image.getHeight() / 2,
+                           juce::Graphics::highResamplingQuality);
+  if (image.getWidth() != width || image.getHeight() != height)
+    image = image.rescaled(width, height,
+                           juce::Graphics::highResamplingQuality);
+
+  const size_t numPixelBytes = size_t(width) * size_t(height) * 4;
+  juce::MemoryBlock pixels(numPixelBytes, false);
+  auto *dest = static_cast<juce::uint8 *>(pixels.getData());
+  {
+    const juce::Image::BitmapData bitmap(image,
+                                         juce::Image::BitmapData::readOnly);
+
+    for (int y = 0; y < height; ++y)
+      for (int x = 0; x < width; ++x, dest += 4) {
+        const auto *pixel = reinterpret_cast<const juce::PixelARGB *>(
+            bitmap.getPixelPointer(x, y));
+        dest[0] = pixel->getBlue();
+        dest[1] = pixel->getGreen();
+        dest[2] = pixel->getRed();
+        dest[3] = pixel->getAlpha();
+      }
+  }
+
+  juce::MemoryOutputStream compressed;
+  {
+    juce::GZIPCompressorOutputStream zlib(compressed, 9);
+    zlib.write(pixels.getData(), numPixelBytes);
+  } // flushed here
+
+  juce::MemoryBlock block(size_t(kHeaderSize), false);
+  auto *bytes = static_cast<juce::uint8 *>(block.getData());
+  detail::writeUint(bytes, kMagic, 4);
+  detail::writeUint(bytes + 4, juce::uint32(kVersion), 2);
+  detail::writeUint(bytes + 6, juce::uint32(juce::roundToInt(scale * 100.0f)),
+                    2);
+  detail::writeUint(bytes + 8, juce::uint32(width), 4);
+  detail::writeUint(bytes + 12, juce::uint32(height), 4);
+  detail::writeUint(bytes + 16, juce::uint32(logicalWidth), 4);
+  detail::writeUint(bytes + 20, juce::uint32(logicalHeight), 4);
+  detail::writeUint(bytes + 24, juce::uint32(compressed.getDataSize()), 4);
+
+  block.append(compressed.getData(), compressed.getDataSize());
+  return block;
+}
+
+} // namespace VT2RAssets
@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+    VT-2R - EMU AUDIO
+    Channel Layout
+
+    Bus layouts with their own processBlock instantiation.
+  ==============================================================================
+*/
+
+#pragma once
+
+namespace VT2RDSP {
+
+//==============================================================================
+/**
+ * Resolved once per block from the bus channel counts. Mono, stereo and
+ * mono -> stereo fix the number of processed channels at compile time, so
+ * their per-channel loops unroll and the lane (de)interleaving takes its
+ * register-only mono / stereo form; everything else (5.1 ... 7.1.4) runs
+ * the general code.
+ *
+ * MonoToStereo processes the single input channel once and copies the
+ * result to the second output.
+ */
+enum class ChannelLayout { Mono, Stereo, MonoToStereo, Multichannel };
+
+inline ChannelLayout getChannelLayout(int numInputs, int numOutputs) {
+  if (numInputs == 1)
+    return numOutputs == 2 ? ChannelLayout::MonoToStereo
+                           : ChannelLayout::Mono;
+  if (numInputs == 2 && numOutputs == 2)
+    return ChannelLayout::Stereo;
+  return ChannelLayout::Multichannel;
+}
+
+/** Channels the wet and dry paths process; 0 = known only at run time. */
+constexpr int getNumProcessedChannels(ChannelLayout layout) {
+  switch (layout) {
+  case ChannelLayout::Mono:
+  case ChannelLayout::MonoToStereo:
+    return 1;
+  case ChannelLayout::Stereo:
+    return 2;
+  case ChannelLayout::Multichannel:
+  default:
+    return 0;
+  }
+}
+
+} // namespace VT2RDSP
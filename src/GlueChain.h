@@ -0,0 +1,340 @@
+/*
+  ==============================================================================
+    VT-2R - EMU AUDIO
+    Glue Chain
+
+    The DSP_DESIGN.md glue stages (tape curve, 2nd/3rd harmonics, transient
+    shaper lite, 80 Hz allpass) as compile-time selectable stages of the
+    fused wet lane kernel (LaneKernel.h).
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "SIMDVector.h"
+#include "VT2RConstants.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace VT2RDSP {
+
+//==============================================================================
+/**
+ * Wet path character (the "character" parameter).
+ *
+ *  - Aggressive: Pre-Emphasis -> Saturation -> Makeup (the original chain)
+ *  - Glue: Pre-Emphasis -> Tape Curve -> Saturation -> Harmonics ->
+ *          Transient Shaper -> Allpass -> Makeup
+ */
+enum class Character { Aggressive = 0, Glue };
+
+/**
+ * Stage selection, resolved at compile time: every stage below is
+ * specialised on its flag, and a disabled stage has no state and no
+ * instructions, so the kernel compiles to exactly the chain that is on.
+ */
+template <bool TapeCurve, bool Harmonics, bool TransientShaper,
+          bool PhaseStabiliser>
+struct GlueStages {
+  static constexpr bool kTapeCurve = TapeCurve;
+  static constexpr bool kHarmonics = Harmonics;
+  static constexpr bool kTransientShaper = TransientShaper;
+  static constexpr bool kPhaseStabiliser = PhaseStabiliser;
+};
+
+using AggressiveStages = GlueStages<false, false, false, false>;
+using GlueCharacterStages = GlueStages<true, true, true, true>;
+
+//==============================================================================
+/** Rate-dependent glue coefficients, computed once per prepare. */
+template <typename SampleType> struct GlueCoefficients {
+  SampleType allpass = 0;         // 1st order allpass at kPhaseStabiliserFreq
+  SampleType dcBlock = 0;         // 2nd harmonic DC blocker pole
+  SampleType envelopeRelease = 0; // transient envelope decay per sample
+
+  /** sampleRate is the processing (oversampled) rate. */
+  void prepare(double sampleRate) {
+    constexpr double kPi = 3.141592653589793238;
+
+    const double t =
+        std::tan(kPi * VT2RConstants::kPhaseStabiliserFreq / sampleRate);
+    allpass = SampleType((t - 1.0) / (t + 1.0));
+    dcBlock = SampleType(std::exp(
+        -2.0 * kPi * VT2RConstants::kHarmonicDcBlockFreq / sampleRate));
+    envelopeRelease = SampleType(std::exp(
+        -1000.0 / (VT2RConstants::kTransientReleaseMs * sampleRate)));
+  }
+
+  /**
+   * Samples (at the prepared rate) until the slower of the allpass and
+   * the DC blocker has decayed by 100 dB (the DC blocker, in practice).
+   */
+  double getTailSamples() const {
+    auto decay = [](double pole) {
+      pole = std::abs(pole);
+      return pole <= 0.0 || pole >= 1.0 ? 0.0
+                                        : std::log(1.0e-5) / std::log(pole);
+    };
+    return std::max(decay(double(allpass)), decay(double(dcBlock)));
+  }
+};
+
+/** Glue stage state, one channel per lane. */
+template <typename SampleType> struct GlueLaneState {
+  SIMDRegister<SampleType> envelope = SIMDRegister<SampleType>::zero();
+  SIMDRegister<SampleType> allpassX1 = SIMDRegister<SampleType>::zero();
+  SIMDRegister<SampleType> allpassY1 = SIMDRegister<SampleType>::zero();
+  SIMDRegister<SampleType> dcX1 = SIMDRegister<SampleType>::zero();
+  SIMDRegister<SampleType> dcY1 = SIMDRegister<SampleType>::zero();
+};
+
+//==============================================================================
+// Stages. Each one loads its state into registers on construction, takes
+// its Drive-dependent amounts once per control sample (setDrive, Drive
+// normalised to 0-1) and writes its state back in store().
+//
+// The primary templates are the disabled stages.
+
+/**
+ * Tape curve x / (1 + k x^2), k = kTapeDensityMax * Drive, ahead of the
+ * saturator's input gain. n is fixed at 2 (the hard end of the 1.5 - 2.0
+ * design range) because lanes have no pow. The curve peaks at 1/sqrt(k)
+ * and folds back beyond, so the input is clamped there.
+ */
+template <typename SampleType, bool Enabled> struct TapeCurveStage {
+  using V = SIMDRegister<SampleType>;
+
+  TapeCurveStage(const GlueCoefficients<SampleType> &,
+                 const GlueLaneState<SampleType> &) {}
+  void setDrive(SampleType) {}
+  V operator()(V x) { return x; }
+  void store(GlueLaneState<SampleType> &) const {}
+};
+
+template <typename SampleType> struct TapeCurveStage<SampleType, true> {
+  using V = SIMDRegister<SampleType>;
+
+  TapeCurveStage(const GlueCoefficients<SampleType> &,
+                 const GlueLaneState<SampleType> &) {}
+
+  void setDrive(SampleType normDrive) {
+    const SampleType k =
+        SampleType(VT2RConstants::kTapeDensityMax) * normDrive;
+    const SampleType limit =
+        k > SampleType(0) ? SampleType(1) / std::sqrt(k) : SampleType(1.0e6f);
+
+    density = V::broadcast(k);
+    upper = V::broadcast(limit);
+    lower = V::broadcast(-limit);
+  }
+
+  V operator()(V x) {
+    x = V::min(V::max(x, lower), upper);
+    return x / (V::broadcast(SampleType(1)) + density * x * x);
+  }
+
+  void store(GlueLaneState<SampleType> &) const {}
+
+private:
+  V density = V::zero();
+  V upper = V::zero();
+  V lower = V::zero();
+};
+
+/**
+ * Low-order harmonics on the saturator output:
+ * y + h2 * y^2 + h3 * y^3, h2 / h3 up to kSecondHarmonicMax /
+ * kThirdHarmonicMax with Drive. The even term carries DC, so it alone
+ * goes through a one-pole DC blocker at kHarmonicDcBlockFreq.
+ */
+template <typename SampleType, bool Enabled> struct HarmonicsStage {
+  using V = SIMDRegister<SampleType>;
+
+  HarmonicsStage(const GlueCoefficients<SampleType> &,
+                 const GlueLaneState<SampleType> &) {}
+  void setDrive(SampleType) {}
+  V operator()(V x) { return x; }
+  void store(GlueLaneState<SampleType> &) const {}
+};
+
+template <typename SampleType> struct HarmonicsStage<SampleType, true> {
+  using V = SIMDRegister<SampleType>;
+
+  HarmonicsStage(const GlueCoefficients<SampleType> &coeffs,
+                 const GlueLaneState<SampleType> &state)
+      : dcBlock(V::broadcast(coeffs.dcBlock)), x1(state.dcX1),
+        y1(state.dcY1) {}
+
+  void setDrive(SampleType normDrive) {
+    second = V::broadcast(SampleType(VT2RConstants::kSecondHarmonicMax) *
+                          normDrive);
+    third =
+        V::broadcast(SampleType(VT2RConstants::kThirdHarmonicMax) * normDrive);
+  }
+
+  V operator()(V x) {
+    const auto squared = x * x;
+    const auto even = squared * second;
+
+    // DC blocker: y[n] = x[n] - x[n-1] + R y[n-1]
+    const auto blocked = even - x1 + dcBlock * y1;
+    x1 = even;
+    y1 = V::flushBelow(blocked, SampleType(1e-20f));
+
+    return x + blocked + squared * x * third;
+  }
+
+  void store(GlueLaneState<SampleType> &state) const {
+    state.dcX1 = x1;
+    state.dcY1 = y1;
+  }
+
+private:
+  V dcBlock;
+  V x1, y1;
+  V second = V::zero();
+  V third = V::zero();
+};
+
+/**
+ * Transient shaper lite: a peak envelope (instant attack, exponential
+ * release) above kTransientThreshold rounds the signal down by up to
+ * amount = kTransientAmountMax * Drive, blended in with a smoothstep over
+ * kTransientKnee. Per channel (lane); the reduction is small enough that
+ * the stereo image does not move.
+ */
+template <typename SampleType, bool Enabled> struct TransientShaperStage {
+  using V = SIMDRegister<SampleType>;
+
+  TransientShaperStage(const GlueCoefficients<SampleType> &,
+                       const GlueLaneState<SampleType> &) {}
+  void setDrive(SampleType) {}
+  V operator()(V x) { return x; }
+  void store(GlueLaneState<SampleType> &) const {}
+};
+
+template <typename SampleType> struct TransientShaperStage<SampleType, true> {
+  using V = SIMDRegister<SampleType>;
+
+  TransientShaperStage(const GlueCoefficients<SampleType> &coeffs,
+                       const GlueLaneState<SampleType> &state)
+      : release(V::broadcast(coeffs.envelopeRelease)),
+        envelope(state.envelope) {}
+
+  void setDrive(SampleType normDrive) {
+    amount = V::broadcast(SampleType(VT2RConstants::kTransientAmountMax) *
+                          normDrive);
+  }
+
+  V operator()(V x) {
+    const auto one = V::broadcast(SampleType(1));
+
+    envelope = V::max(envelope * release, V::abs(x));
+    envelope = V::flushBelow(envelope, SampleType(1e-20f));
+
+    // smoothstep(threshold, threshold + knee, envelope)
+    auto t = (envelope - V::broadcast(SampleType(
+                             VT2RConstants::kTransientThreshold))) *
+             V::broadcast(SampleType(1) /
+                          SampleType(VT2RConstants::kTransientKnee));
+    t = V::min(V::max(t, V::zero()), one);
+    const auto reduction =
+        t * t * (V::broadcast(SampleType(3)) - V::broadcast(SampleType(2)) * t);
+
+    return x * (one - reduction * amount);
+  }
+
+  void store(GlueLaneState<SampleType> &state) const {
+    state.envelope = envelope;
+  }
+
+private:
+  V release;
+  V envelope;
+  V amount = V::zero();
+};
+
+/**
+ * Phase stabiliser: 1st order allpass at kPhaseStabiliserFreq,
+ * y[n] = c (x[n] - y[n-1]) + x[n-1]. Identical on every lane, so linked
+ * channels stay phase aligned.
+ */
+template <typename SampleType, bool Enabled> struct PhaseStabiliserStage {
+  using V = SIMDRegister<SampleType>;
+
+  PhaseStabiliserStage(const GlueCoefficients<SampleType> &,
+                       const GlueLaneState<SampleType> &) {}
+  void setDrive(SampleType) {}
+  V operator()(V x) { return x; }
+  void store(GlueLaneState<SampleType> &) const {}
+};
+
+template <typename SampleType> struct PhaseStabiliserStage<SampleType, true> {
+  using V = SIMDRegister<SampleType>;
+
+  PhaseStabiliserStage(const GlueCoefficients<SampleType> &coeffs,
+                       const GlueLaneState<SampleType> &state)
+      : coefficient(V::broadcast(coeffs.allpass)), x1(state.allpassX1),
+        y1(state.allpassY1) {}
+
+  void setDrive(SampleType) {}
+
+  V operator()(V x) {
+    const auto y = coefficient * (x - y1) + x1;
+    x1 = x;
+    y1 = V::flushBelow(y, SampleType(1e-20f));
+    return y;
+  }
+
+  void store(GlueLaneState<SampleType> &state) const {
+    state.allpassX1 = x1;
+    state.allpassY1 = y1;
+  }
+
+private:
+  V coefficient;
+  V x1, y1;
+};
+
+//==============================================================================
+/**
+ * The enabled stages of Stages around the saturator, for one lane group:
+ * beforeSaturation() ahead of the input gain, afterSaturation() between
+ * the saturator and the makeup gain. Construct at the top of a kernel
+ * pass, store() at the end.
+ */
+template <typename SampleType, typename Stages> class GlueChain {
+public:
+  using V = SIMDRegister<SampleType>;
+
+  GlueChain(const GlueCoefficients<SampleType> &coeffs,
+            const GlueLaneState<SampleType> &state)
+      : tape(coeffs, state), harmonics(coeffs, state),
+        transient(coeffs, state), phase(coeffs, state) {}
+
+  void setDrive(SampleType normDrive) {
+    tape.setDrive(normDrive);
+    harmonics.setDrive(normDrive);
+    transient.setDrive(normDrive);
+    phase.setDrive(normDrive);
+  }
+
+  V beforeSaturation(V x) { return tape(x); }
+  V afterSaturation(V x) { return phase(transient(harmonics(x))); }
+
+  void store(GlueLaneState<SampleType> &state) const {
+    tape.store(state);
+    harmonics.store(state);
+    transient.store(state);
+    phase.store(state);
+  }
+
+private:
+  TapeCurveStage<SampleType, Stages::kTapeCurve> tape;
+  HarmonicsStage<SampleType, Stages::kHarmonics> harmonics;
+  TransientShaperStage<SampleType, Stages::kTransientShaper> transient;
+  PhaseStabiliserStage<SampleType, Stages::kPhaseStabiliser> phase;
+};
+
+} // namespace VT2RDSP
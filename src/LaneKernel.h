@@ -0,0 +1,267 @@
+/*
+  ==============================================================================
+    VT-2R - EMU AUDIO
+    Channel Lane Kernel
+
+    Pre-Emphasis -> [Glue stages] -> Saturation -> [Glue stages] -> Makeup
+    for SIMDRegister::kNumLanes channels at once (one channel per lane),
+    float or double, in a single pass.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "AntiderivativeSaturation.h"
+#include "GlueChain.h"
+#include "PreEmphasisTable.h"
+#include "SIMDVector.h"
+#include "SaturationFunctions.h"
+
+namespace VT2RDSP {
+
+//==============================================================================
+/**
+ * Biquad (DF2) state, one channel per lane, and the peak saturator input
+ * (|driven|) per lane since the processor last cleared it - the saturation
+ * meter's measure, after pre-emphasis, gain and glue stages.
+ */
+template <typename SampleType> struct LaneFilterState {
+  SIMDRegister<SampleType> z1 = SIMDRegister<SampleType>::zero();
+  SIMDRegister<SampleType> z2 = SIMDRegister<SampleType>::zero();
+  SIMDRegister<SampleType> drivenPeak = SIMDRegister<SampleType>::zero();
+};
+
+/**
+ * Per-sample control values, shared by every lane.
+ * Filled once per slice by the processor from the smoothed parameters.
+ */
+template <typename SampleType> struct ControlSlice {
+  const SampleType *inputGain;  // saturator drive gain
+  const SampleType *makeupGain; // auto makeup
+  const SampleType *normDrive;  // Drive / 100, glue stage amounts
+};
+
+//==============================================================================
+/**
+ * Wet path: Pre-Emphasis -> Saturation -> Makeup, with the glue stages of
+ * Stages (GlueChain.h) fused around the saturator, in place on one lane
+ * group (see Oversampler / interleaveLanes).
+ *
+ * Processes numSamples control samples; with oversampling each control
+ * sample covers oversamplingFactor consecutive vectors of lanes. Every
+ * stage runs on a vector while it is in registers, so the chain is one
+ * pass over the lanes whichever stages are on. Lane arithmetic follows the
+ * scalar chain operation for operation, so with AggressiveStages results
+ * match the per-channel code for the same Saturator.
+ *
+ * Stages: AggressiveStages or GlueCharacterStages (explicit template
+ * argument); disabled stages compile to nothing.
+ * SampleType: float or double - coefficients, state and control values all
+ * follow it, so neither precision converts anything per block.
+ * Saturator: one of the tanh implementations in SaturationFunctions.h, or
+ * an ADAA tanh (AntiderivativeSaturation.h) bound to this lane group's
+ * history - called once per vector, in order.
+ */
+template <typename Stages, typename SampleType, typename Saturator>
+void processWetLanes(SIMDRegister<SampleType> *lanes, int numSamples,
+                     int oversamplingFactor,
+                     const BiquadCoefficients<SampleType> &coeffs,
+                     const GlueCoefficients<SampleType> &glueCoeffs,
+                     const ControlSlice<SampleType> &control,
+                     LaneFilterState<SampleType> &state,
+                     GlueLaneState<SampleType> &glueState,
+                     const Saturator &saturate) {
+  using V = SIMDRegister<SampleType>;
+
+  const auto b0 = V::broadcast(coeffs.b0);
+  const auto b1 = V::broadcast(coeffs.b1);
+  const auto b2 = V::broadcast(coeffs.b2);
+  const auto a1 = V::broadcast(coeffs.a1);
+  const auto a2 = V::broadcast(coeffs.a2);
+
+  auto z1 = state.z1;
+  auto z2 = state.z2;
+  auto peak = state.drivenPeak;
+  GlueChain<SampleType, Stages> glue(glueCoeffs, glueState);
+
+  int n = 0;
+
+  for (int i = 0; i < numSamples; ++i) {
+    const auto inputGain = V::broadcast(control.inputGain[i]);
+    const auto makeupGain = V::broadcast(control.makeupGain[i]);
+    glue.setDrive(control.normDrive[i]);
+
+    for (int j = 0; j < oversamplingFactor; ++j, ++n) {
+      const auto x = lanes[n];
+
+      // 1. Pre-Emphasis (DF2 biquad)
+      auto w = x - a1 * z1 - a2 * z2;
+      const auto emphasised = b0 * w + b1 * z1 + b2 * z2;
+
+      // Denormal protection
+      w = V::flushBelow(w, SampleType(1e-20f));
+      z2 = z1;
+      z1 = w;
+
+      // 2. Saturation (tape curve / harmonics, transient, allpass around
+      // it)  3. Output makeup
+      const auto driven = glue.beforeSaturation(emphasised) * inputGain;
+      peak = V::max(peak, V::abs(driven));
+      lanes[n] = glue.afterSaturation(saturate(driven)) * makeupGain;
+    }
+  }
+
+  state.z1 = z1;
+  state.z2 = z2;
+  state.drivenPeak = peak;
+  glue.store(glueState);
+}
+
+/**
+ * processWetLanes for a settled Drive: one input/makeup gain for all
+ * numVectors lane vectors (numSamples * oversamplingFactor), so the gains
+ * are broadcast once instead of once per control sample.
+ */
+template <typename Stages, typename SampleType, typename Saturator>
+void processWetLanesConstant(SIMDRegister<SampleType> *lanes, int numVectors,
+                             const BiquadCoefficients<SampleType> &coeffs,
+                             const GlueCoefficients<SampleType> &glueCoeffs,
+                             SampleType inputGain, SampleType makeupGain,
+                             SampleType normDrive,
+                             LaneFilterState<SampleType> &state,
+                             GlueLaneState<SampleType> &glueState,
+                             const Saturator &saturate) {
+  const ControlSlice<SampleType> control{&inputGain, &makeupGain, &normDrive};
+  processWetLanes<Stages>(lanes, 1, numVectors, coeffs, glueCoeffs, control,
+                          state, glueState, saturate);
+}
+
+/**
+ * processWetLanesConstant for a mono lane group (the channel in lane 0)
+ * with AggressiveStages and a stateless saturator. The chain's only memory
+ * is then the pre-emphasis biquad, so time goes into the lanes instead:
+ * kNumLanes consecutive samples pass the biquad at once in block form
+ * (BlockBiquadMatrices, one dependent step per block instead of per
+ * sample), then the gains and one saturator call as a single vector.
+ * Vectors past the last whole block take the per-sample path. Lanes other
+ * than 0 stay zero, so either path can follow the other.
+ *
+ * Differs from processWetLanesConstant by the rounding of the block sums,
+ * and the denormal flush applies to the state at block ends
+ * (vt2r_compare checks the block form against the recursion).
+ */
+template <typename SampleType, typename Saturator>
+void processMonoLanesConstant(SIMDRegister<SampleType> *lanes, int numVectors,
+                              const BiquadCoefficients<SampleType> &coeffs,
+                              const BlockBiquadMatrices<SampleType> &matrices,
+                              const GlueCoefficients<SampleType> &glueCoeffs,
+                              SampleType inputGain, SampleType makeupGain,
+                              SampleType normDrive,
+                              LaneFilterState<SampleType> &state,
+                              GlueLaneState<SampleType> &glueState,
+                              const Saturator &saturate) {
+  using V = SIMDRegister<SampleType>;
+  constexpr int N = V::kNumLanes;
+  static_assert(BlockBiquadMatrices<SampleType>::kBlockSize == N,
+                "one block per vector");
+
+  // Toeplitz columns: input sample j reaches outputs j ... N-1
+  V hColumns[N], gColumns[N];
+  alignas(V::kAlignment) SampleType column[N];
+
+  for (int j = 0; j < N; ++j) {
+    for (int k = 0; k < N; ++k)
+      column[k] = k >= j ? matrices.h[k - j] : SampleType(0);
+    hColumns[j] = V::load(column);
+
+    for (int k = 0; k < N; ++k)
+      column[k] = k >= j ? matrices.g[k - j] : SampleType(0);
+    gColumns[j] = V::load(column);
+  }
+
+  const auto yz1 = V::load(matrices.yz1);
+  const auto yz2 = V::load(matrices.yz2);
+  const auto wz1 = V::load(matrices.wz1);
+  const auto wz2 = V::load(matrices.wz2);
+  const auto gainIn = V::broadcast(inputGain);
+  const auto gainOut = V::broadcast(makeupGain);
+
+  // Lane 0 only (see interleaveLanes)
+  alignas(V::kAlignment) SampleType laneIndices[N];
+  for (int l = 0; l < N; ++l)
+    laneIndices[l] = SampleType(l);
+  const auto index = V::load(laneIndices);
+  const auto one = V::broadcast(SampleType(1));
+
+  SampleType z1 = state.z1.firstLane();
+  SampleType z2 = state.z2.firstLane();
+  auto peak = state.drivenPeak;
+
+  const int numBlocks = numVectors / N;
+  alignas(V::kAlignment) SampleType x[N], w[N], out[N];
+
+  for (int b = 0; b < numBlocks; ++b) {
+    auto *block = lanes + b * N;
+    for (int k = 0; k < N; ++k)
+      x[k] = block[k].firstLane();
+
+    // 1. Pre-Emphasis, N samples from the state at the block start
+    auto y = yz1 * V::broadcast(z1) + yz2 * V::broadcast(z2);
+    auto wNext = wz1 * V::broadcast(z1) + wz2 * V::broadcast(z2);
+    for (int j = 0; j < N; ++j) {
+      const auto xj = V::broadcast(x[j]);
+      y = y + hColumns[j] * xj;
+      wNext = wNext + gColumns[j] * xj;
+    }
+
+    wNext.store(w);
+    z1 = std::abs(w[N - 1]) < SampleType(1e-20f) ? SampleType(0) : w[N - 1];
+    z2 = std::abs(w[N - 2]) < SampleType(1e-20f) ? SampleType(0) : w[N - 2];
+
+    // 2. Saturation  3. Output makeup
+    const auto driven = y * gainIn;
+    peak = V::max(peak, V::abs(driven));
+    (saturate(driven) * gainOut).store(out);
+
+    for (int k = 0; k < N; ++k)
+      block[k] = V::selectLess(index, one, V::broadcast(out[k]), V::zero());
+  }
+
+  state.z1 = V::selectLess(index, one, V::broadcast(z1), V::zero());
+  state.z2 = V::selectLess(index, one, V::broadcast(z2), V::zero());
+  state.drivenPeak = peak;
+
+  processWetLanesConstant<AggressiveStages>(
+      lanes + numBlocks * N, numVectors - numBlocks * N, coeffs, glueCoeffs,
+      inputGain, makeupGain, normDrive, state, glueState, saturate);
+}
+
+/**
+ * Drive 0: the pre-emphasis is a flat 0 dB biquad, both gains are 1 and
+ * the tape curve is linear, so the wet path is the saturator alone, plus
+ * the allpass with Glue. The other glue stages keep running at zero
+ * amount so their filters decay as they would at any other Drive.
+ * Of state, only its drivenPeak is used.
+ */
+template <typename Stages, typename SampleType, typename Saturator>
+void saturateLanes(SIMDRegister<SampleType> *lanes, int numVectors,
+                   const GlueCoefficients<SampleType> &glueCoeffs,
+                   LaneFilterState<SampleType> &state,
+                   GlueLaneState<SampleType> &glueState,
+                   const Saturator &saturate) {
+  using V = SIMDRegister<SampleType>;
+
+  GlueChain<SampleType, Stages> glue(glueCoeffs, glueState);
+  glue.setDrive(SampleType(0));
+  auto peak = state.drivenPeak;
+
+  for (int n = 0; n < numVectors; ++n) {
+    peak = V::max(peak, V::abs(lanes[n]));
+    lanes[n] = glue.afterSaturation(saturate(lanes[n]));
+  }
+
+  state.drivenPeak = peak;
+  glue.store(glueState);
+}
+
+} // namespace VT2RDSP
@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+    VT-2R - EMU AUDIO
+    Meter FIFO
+
+    Audio thread -> UI thread level data. Wait-free single-producer /
+    single-consumer ring: no locks, no allocation after construction.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace VT2RDSP {
+
+//==============================================================================
+/** Levels of one processed block, the maximum over all channels (linear). */
+struct MeterFrame {
+  float inputPeak = 0.0f;
+  float inputRms = 0.0f;
+  float outputPeak = 0.0f;
+  float outputRms = 0.0f;
+
+  // Saturator compression at the driven input peak: 1 - tanh(x) / x.
+  // 0 = linear, towards 1 = hard limiting.
+  float saturation = 0.0f;
+};
+
+//==============================================================================
+/**
+ * Single-producer / single-consumer ring buffer.
+ *
+ * push() is called by exactly one thread (audio), pop() by exactly one
+ * other thread (UI). Both are wait-free; a full FIFO drops the new item
+ * rather than blocking the producer.
+ */
+template <typename Item, int Capacity> class SPSCFifo {
+public:
+  static_assert((Capacity & (Capacity - 1)) == 0 && Capacity > 0,
+                "Capacity must be a power of two");
+  static_assert(std::is_trivially_copyable_v<Item>,
+                "Items are copied by value across threads");
+
+  /** Producer side. Returns false (item dropped) when full. */
+  bool push(const Item &item) {
+    const auto write = writeIndex.load(std::memory_order_relaxed);
+    const auto read = readIndex.load(std::memory_order_acquire);
+
+    if (write - read == uint32_t(Capacity))
+      return false;
+
+    items[write & kMask] = item;
+    writeIndex.store(write + 1, std::memory_order_release);
+    return true;
+  }
+
+  /** Consumer side. Returns false when empty. */
+  bool pop(Item &item) {
+    const auto read = readIndex.load(std::memory_order_relaxed);
+    const auto write = writeIndex.load(std::memory_order_acquire);
+
+    if (read == write)
+      return false;
+
+    item = items[read & kMask];
+    readIndex.store(read + 1, std::memory_order_release);
+    return true;
+  }
+
+private:
+  static constexpr uint32_t kMask = uint32_t(Capacity - 1);
+
+  std::array<Item, std::size_t(Capacity)> items{};
+
+  // Separate cache lines: each index is written by one thread only
+  alignas(64) std::atomic<uint32_t> writeIndex{0};
+  alignas(64) std::atomic<uint32_t> readIndex{0};
+};
+
+// ~0.7 s of blocks at 48 kHz / 256 before the UI has to catch up
+using MeterFifo = SPSCFifo<MeterFrame, 128>;
+
+} // namespace VT2RDSP
@@ -0,0 +1,566 @@
+/*
+  ==============================================================================
+    VT-2R - EMU AUDIO
+    Oversampler
+
+    Cascaded polyphase half-band up/down sampling (2x / 4x / 8x).
+    Linear phase (FIR) or minimum phase (IIR allpass pair) filter sets.
+    Channels are processed kNumLanes at a time as SIMD lanes, in float or
+    double (SampleType).
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "SIMDVector.h"
+#include "SharedTableRegistry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace VT2RDSP {
+
+enum class OversamplingFilter { MinimumPhase = 0, LinearPhase };
+
+//==============================================================================
+/**
+ * Linear phase half-band FIR (Kaiser windowed sinc), polyphase.
+ *
+ * numTaps = 4m + 3, so the centre tap sits on an odd index and every other
+ * tap is zero. Up: even outputs run the (2m + 2)-tap branch, odd outputs are
+ * the input delayed by m. Down: the same branch plus the delayed centre tap.
+ *
+ * State is kept per lane group; one call filters kNumLanes channels. The
+ * taps are shared by every filter with the same design in the process.
+ */
+template <typename SampleType> class HalfBandFIR {
+public:
+  using Vector = SIMDRegister<SampleType>;
+
+  void design(int numTaps, double kaiserBeta) {
+    m = (numTaps - 3) / 4;
+    branchLength = 2 * m + 2;
+
+    static SharedTableRegistry<std::pair<int, double>, std::vector<Vector>>
+        registry;
+    taps = registry.acquire({m, kaiserBeta},
+                            [&] { return designTaps(m, kaiserBeta); });
+  }
+
+  void prepare(int numGroups) {
+    groups.assign(size_t(numGroups), {});
+    for (auto &g : groups) {
+      g.upHistory.assign(size_t(branchLength * 2), Vector::zero());
+      g.evenHistory.assign(size_t(branchLength * 2), Vector::zero());
+      g.oddHistory.assign(size_t(branchLength * 2), Vector::zero());
+    }
+  }
+
+  void reset() {
+    for (int g = 0; g < int(groups.size()); ++g)
+      reset(g);
+  }
+
+  void reset(int group) {
+    auto &g = groups[size_t(group)];
+    std::fill(g.upHistory.begin(), g.upHistory.end(), Vector::zero());
+    std::fill(g.evenHistory.begin(), g.evenHistory.end(), Vector::zero());
+    std::fill(g.oddHistory.begin(), g.oddHistory.end(), Vector::zero());
+    g.upPos = g.downPos = 0;
+  }
+
+  /** numSamples in -> 2 * numSamples out */
+  void up(int group, const Vector *in, Vector *out, int numSamples) {
+    auto &g = groups[size_t(group)];
+    const int L = branchLength;
+    const auto two = Vector::broadcast(2.0f);
+
+    for (int i = 0; i < numSamples; ++i) {
+      const Vector *w = push(g.upHistory, g.upPos, L, in[i]);
+      out[2 * i] = two * dot(w, L);
+      out[2 * i + 1] = w[L - 1 - m];
+    }
+  }
+
+  /** 2 * numSamples in -> numSamples out */
+  void down(int group, const Vector *in, Vector *out, int numSamples) {
+    auto &g = groups[size_t(group)];
+    const int L = branchLength;
+    const auto half = Vector::broadcast(0.5f);
+
+    for (int i = 0; i < numSamples; ++i) {
+      int pos = g.downPos;
+      const Vector *we = push(g.evenHistory, pos, L, in[2 * i]);
+      const Vector *wo = push(g.oddHistory, g.downPos, L, in[2 * i + 1]);
+      out[i] = dot(we, L) + half * wo[L - 2 - m];
+    }
+  }
+
+  /** Group delay of one filter pass at the high rate. */
+  double getDelay() const { return double(2 * m + 1); }
+
+private:
+  int m = 0;
+  int branchLength = 2;
+  std::shared_ptr<const std::vector<Vector>> taps; // see designTaps
+
+  struct GroupState {
+    std::vector<Vector> upHistory, evenHistory, oddHistory;
+    int upPos = 0, downPos = 0;
+  };
+  std::vector<GroupState> groups;
+
+  /** Double-written ring; returns the chronological window of L samples. */
+  static const Vector *push(std::vector<Vector> &history, int &pos, int L,
+                            Vector x) {
+    history[size_t(pos)] = x;
+    history[size_t(pos + L)] = x;
+    const Vector *window = history.data() + pos + 1;
+    pos = pos + 1 < L ? pos + 1 : 0;
+    return window;
+  }
+
+  Vector dot(const Vector *window, int L) const {
+    const Vector *h = taps->data();
+    auto acc = Vector::zero();
+    for (int k = 0; k < L; ++k)
+      acc = acc + h[k] * window[k];
+    return acc;
+  }
+
+  /** Reversed even-index taps of the 4m + 3 tap design, broadcast. */
+  static std::vector<Vector> designTaps(int m, double kaiserBeta) {
+    const int centre = 2 * m + 1;
+    const int branchLength = 2 * m + 2;
+    const double kPi = 3.141592653589793238;
+    std::vector<Vector> taps(size_t(branchLength), Vector::zero());
+
+    double sum = 0.0;
+    std::vector<double> h(static_cast<size_t>(branchLength));
+    for (int j = 0; j < branchLength; ++j) {
+      const int k = 2 * j; // even index -> odd distance from centre
+      const double t = double(k - centre);
+      const double sinc = std::sin(kPi * t / 2.0) / (kPi * t);
+      const double r = t / double(centre);
+      const double window =
+          besselI0(kaiserBeta * std::sqrt(std::max(0.0, 1.0 - r * r))) /
+          besselI0(kaiserBeta);
+      h[size_t(j)] = sinc * window;
+      sum += h[size_t(j)];
+    }
+
+    // Each polyphase branch must have a DC gain of exactly 0.5
+    for (int j = 0; j < branchLength; ++j)
+      taps[size_t(branchLength - 1 - j)] =
+          Vector::broadcast(SampleType(h[size_t(j)] * 0.5 / sum));
+    return taps;
+  }
+
+  static double besselI0(double x) {
+    double sum = 1.0, term = 1.0;
+    for (int k = 1; k < 50; ++k) {
+      term *= (x / (2.0 * k)) * (x / (2.0 * k));
+      sum += term;
+      if (term < sum * 1e-12)
+        break;
+    }
+    return sum;
+  }
+};
+
+//==============================================================================
+/**
+ * Minimum phase half-band filter: two parallel chains of first order
+ * allpass sections in z^-2 (polyphase IIR), coefficients designed for a
+ * given order and transition bandwidth (elliptic prototype, as in
+ * Valenzuela & Constantinides). State is kept per lane group.
+ */
+template <typename SampleType> class HalfBandIIR {
+public:
+  using Vector = SIMDRegister<SampleType>;
+
+  /** numCoefs must be even. transition is relative to the high rate. */
+  void design(int numCoefs, double transition) {
+    static SharedTableRegistry<std::pair<int, double>, std::vector<Vector>>
+        registry;
+
+    coefs = registry.acquire({numCoefs, transition}, [&] {
+      return designCoefs(numCoefs, transition);
+    });
+  }
+
+  void prepare(int numGroups) {
+    upStates.assign(size_t(numGroups), State(coefs->size()));
+    downStates.assign(size_t(numGroups), State(coefs->size()));
+  }
+
+  void reset() {
+    for (int g = 0; g < int(upStates.size()); ++g)
+      reset(g);
+  }
+
+  void reset(int group) {
+    for (auto *states : {&upStates, &downStates}) {
+      auto &s = (*states)[size_t(group)];
+      std::fill(s.x.begin(), s.x.end(), Vector::zero());
+      std::fill(s.y.begin(), s.y.end(), Vector::zero());
+    }
+  }
+
+  void up(int group, const Vector *in, Vector *out, int numSamples) {
+    auto &s = upStates[size_t(group)];
+    for (int i = 0; i < numSamples; ++i) {
+      auto even = in[i];
+      auto odd = in[i];
+      processPair(s, even, odd);
+      out[2 * i] = even;
+      out[2 * i + 1] = odd;
+    }
+  }
+
+  void down(int group, const Vector *in, Vector *out, int numSamples) {
+    auto &s = downStates[size_t(group)];
+    const auto half = Vector::broadcast(0.5f);
+    for (int i = 0; i < numSamples; ++i) {
+      auto a = in[2 * i + 1];
+      auto b = in[2 * i];
+      processPair(s, a, b);
+      out[i] = half * (a + b);
+    }
+  }
+
+private:
+  // Shared between instances with the same design (broadcast)
+  std::shared_ptr<const std::vector<Vector>> coefs;
+
+  struct State {
+    explicit State(size_t n = 0) : x(n, Vector::zero()), y(n, Vector::zero()) {}
+    std::vector<Vector> x, y;
+  };
+  std::vector<State> upStates, downStates;
+
+  void processPair(State &s, Vector &a, Vector &b) const {
+    const Vector *c = coefs->data();
+    const size_t n = coefs->size();
+    for (size_t i = 0; i < n; i += 2) {
+      auto ta = (a - s.y[i]) * c[i] + s.x[i];
+      s.x[i] = a;
+      s.y[i] = ta;
+      a = ta;
+
+      auto tb = (b - s.y[i + 1]) * c[i + 1] + s.x[i + 1];
+      s.x[i + 1] = b;
+      s.y[i + 1] = tb;
+      b = tb;
+    }
+
+    // Denormal protection for the decaying recursion
+    for (size_t i = 0; i < n; ++i)
+      s.y[i] = Vector::flushBelow(s.y[i], SampleType(1e-20f));
+  }
+
+  /** Allpass coefficients of both branches, interleaved, broadcast. */
+  static std::vector<Vector> designCoefs(int numCoefs, double transition) {
+    const double kPi = 3.141592653589793238;
+
+    double k = std::tan((1.0 - transition * 2.0) * kPi / 4.0);
+    k *= k;
+    const double kksqrt = std::pow(1.0 - k * k, 0.25);
+    const double e = 0.5 * (1.0 - kksqrt) / (1.0 + kksqrt);
+    const double e4 = e * e * e * e;
+    const double q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+    const int order = numCoefs * 2 + 1;
+
+    std::vector<Vector> coefs(size_t(numCoefs), Vector::zero());
+
+    for (int index = 0; index < numCoefs; ++index) {
+      const int c = index + 1;
+
+      double num = 0.0, term = 0.0;
+      for (int i = 0, sign = 1;; ++i, sign = -sign) {
+        term = std::pow(q, i * (i + 1)) *
+               std::sin((i * 2 + 1) * c * kPi / order) * sign;
+        num += term;
+        if (std::abs(term) < 1e-100 || i > 100)
+          break;
+      }
+
+      double den = 0.0;
+      for (int i = 1, sign = -1;; ++i, sign = -sign) {
+        term = std::pow(q, i * i) * std::cos(i * 2 * c * kPi / order) * sign;
+        den += term;
+        if (std::abs(term) < 1e-100 || i > 100)
+          break;
+      }
+
+      const double ww = num * std::pow(q, 0.25) / (den + 0.5);
+      const double wwsq = ww * ww;
+      const double x =
+          std::sqrt((1.0 - wwsq * k) * (1.0 - wwsq / k)) / (1.0 + wwsq);
+      coefs[size_t(index)] =
+          Vector::broadcast(SampleType((1.0 - x) / (1.0 + x)));
+    }
+    return coefs;
+  }
+};
+
+//==============================================================================
+/**
+ * Oversampler
+ *
+ * 2^numStages oversampling as a cascade of half-band stages. All buffers and
+ * filter states are allocated in prepare(); processing never allocates.
+ *
+ * Channels are interleaved into lane buffers on the way up (one Vector
+ * per sample, kNumLanes channels per group) and stay interleaved until the
+ * way down, so every stage and the wet kernel in between run on whole
+ * vectors. With numStages == 0 the oversampler only (de)interleaves.
+ *
+ * Latency: the round trip (up + down) is measured in prepare() from the
+ * impulse response (group delay at DC) and padded with a short delay at the
+ * oversampled rate so that it becomes a whole number of base-rate samples.
+ * That value is what the host gets via setLatencySamples and what the dry
+ * path is delayed by. Linear phase: exact at all frequencies. Minimum phase:
+ * the group delay varies with frequency (at 48 kHz within 0.25 samples of
+ * the integer latency up to 5 kHz at 2x, diverging in the top octave), so a
+ * parallel dry path needs the same filters rather than a delay line.
+ */
+template <typename SampleType> class Oversampler {
+public:
+  using Vector = SIMDRegister<SampleType>;
+
+  static constexpr int kMaxStages = 3; // 8x
+
+  void prepare(int numStagesToUse, OversamplingFilter filterType,
+               int numChannelsToUse, int maxBlockSize) {
+    numStages = std::clamp(numStagesToUse, 0, kMaxStages);
+    filter = filterType;
+    numChannels = numChannelsToUse;
+    numGroups = getNumLaneGroups<SampleType>(numChannels);
+    maxSamples = maxBlockSize;
+
+    firStages.assign(size_t(numStages), {});
+    iirStages.assign(size_t(numStages), {});
+
+    for (int s = 0; s < numStages; ++s) {
+      // Later stages only need to reject images far above the audio band
+      if (filter == OversamplingFilter::LinearPhase) {
+        static constexpr int kTaps[kMaxStages] = {111, 23, 15};
+        firStages[size_t(s)].design(kTaps[s], 8.0);
+        firStages[size_t(s)].prepare(numGroups);
+      } else {
+        static constexpr int kCoefs[kMaxStages] = {8, 4, 4};
+        static constexpr double kTransition[kMaxStages] = {0.0227, 0.13, 0.19};
+        iirStages[size_t(s)].design(kCoefs[s], kTransition[s]);
+        iirStages[size_t(s)].prepare(numGroups);
+      }
+    }
+
+    // Lane buffers: buffers[s] holds maxSamples * 2^s per group
+    buffers.assign(size_t(numStages + 1), {});
+    for (int s = 0; s <= numStages; ++s)
+      buffers[size_t(s)].assign(
+          size_t(numGroups),
+          std::vector<Vector>(size_t(maxSamples) << s, Vector::zero()));
+
+    measureLatency();
+    reset();
+  }
+
+  void reset() {
+    for (int g = 0; g < numGroups; ++g)
+      resetGroup(g);
+  }
+
+  /** Clears lane group g alone (filter histories and alignment delay). */
+  void resetGroup(int g) {
+    for (int s = 0; s < numStages; ++s) {
+      if (filter == OversamplingFilter::LinearPhase)
+        firStages[size_t(s)].reset(g);
+      else
+        iirStages[size_t(s)].reset(g);
+    }
+
+    if (!alignDelay.empty()) {
+      auto &d = alignDelay[size_t(g)];
+      std::fill(d.begin(), d.end(), Vector::zero());
+      alignPos[size_t(g)] = 0;
+    }
+  }
+
+  int getFactor() const { return 1 << numStages; }
+  OversamplingFilter getFilter() const { return filter; }
+
+  /** Number of lane groups (ceil(numChannels / kNumLanes)). */
+  int getNumGroups() const { return numGroups; }
+
+  /** Round-trip latency in base-rate samples (integer, aligned). */
+  int getLatencySamples() const { return latencySamples; }
+
+  /** Base-rate samples until the round-trip impulse response dies out. */
+  int getTailSamples() const { return tailSamples; }
+
+  /** Oversampled lanes of a group written by processUp
+      (numSamples * factor vectors). */
+  Vector *getLanes(int group) {
+    return buffers[size_t(numStages)][size_t(group)].data();
+  }
+
+  /** Interleaves and upsamples numSamples (<= maxBlockSize) of the first
+      channelsToProcess input channels. */
+  void processUp(const SampleType *const *input, int channelsToProcess,
+                 int numSamples) {
+    const int count = std::min(channelsToProcess, numChannels);
+
+    for (int g = 0; g < getNumLaneGroups<SampleType>(count); ++g)
+      processUpGroup(g, input, channelsToProcess, numSamples);
+  }
+
+  /** Downsamples the oversampled lanes and deinterleaves them into output
+      (numSamples each). */
+  void processDown(SampleType *const *output, int channelsToProcess,
+                   int numSamples) {
+    const int count = std::min(channelsToProcess, numChannels);
+
+    for (int g = 0; g < getNumLaneGroups<SampleType>(count); ++g)
+      processDownGroup(g, output, channelsToProcess, numSamples);
+  }
+
+  /**
+   * processUp / processDown for lane group g alone. Groups share no state
+   * (the alignment delay position included), so different groups may run
+   * on different threads at the same time, and one group may run several
+   * blocks ahead of another.
+   */
+  void processUpGroup(int g, const SampleType *const *input,
+                      int channelsToProcess, int numSamples) {
+    const int count = std::min(channelsToProcess, numChannels);
+    const int first = g * Vector::kNumLanes;
+    interleaveLaneGroup(input, first,
+                        std::min(Vector::kNumLanes, count - first),
+                        numSamples, buffers[0][size_t(g)].data());
+
+    int n = numSamples;
+    for (int s = 0; s < numStages; ++s) {
+      const Vector *src = buffers[size_t(s)][size_t(g)].data();
+      Vector *dst = buffers[size_t(s + 1)][size_t(g)].data();
+      if (filter == OversamplingFilter::LinearPhase)
+        firStages[size_t(s)].up(g, src, dst, n);
+      else
+        iirStages[size_t(s)].up(g, src, dst, n);
+      n *= 2;
+    }
+  }
+
+  void processDownGroup(int g, SampleType *const *output,
+                        int channelsToProcess, int numSamples) {
+    const int count = std::min(channelsToProcess, numChannels);
+    applyAlignDelay(g, getLanes(g), numSamples * getFactor());
+
+    int n = numSamples * getFactor();
+    for (int s = numStages - 1; s >= 0; --s) {
+      const Vector *src = buffers[size_t(s + 1)][size_t(g)].data();
+      Vector *dst = buffers[size_t(s)][size_t(g)].data();
+      n /= 2;
+      if (filter == OversamplingFilter::LinearPhase)
+        firStages[size_t(s)].down(g, src, dst, n);
+      else
+        iirStages[size_t(s)].down(g, src, dst, n);
+    }
+
+    const int first = g * Vector::kNumLanes;
+    deinterleaveLaneGroup(buffers[0][size_t(g)].data(), output, first,
+                          std::min(Vector::kNumLanes, count - first),
+                          numSamples);
+  }
+
+private:
+  int numStages = 0;
+  OversamplingFilter filter = OversamplingFilter::MinimumPhase;
+  int numChannels = 0;
+  int numGroups = 0;
+  int maxSamples = 0;
+
+  std::vector<HalfBandFIR<SampleType>> firStages;
+  std::vector<HalfBandIIR<SampleType>> iirStages;
+  std::vector<std::vector<std::vector<Vector>>> buffers; // [stage][group]
+
+  // Fractional-latency padding at the oversampled rate
+  std::vector<std::vector<Vector>> alignDelay; // [group]
+  std::vector<int> alignPos;                   // [group]
+  int alignSamples = 0;
+
+  int latencySamples = 0;
+  int tailSamples = 0;
+
+  void applyAlignDelay(int group, Vector *data, int n) {
+    if (alignSamples == 0)
+      return;
+
+    auto &d = alignDelay[size_t(group)];
+    int pos = alignPos[size_t(group)];
+    for (int i = 0; i < n; ++i) {
+      auto delayed = d[size_t(pos)];
+      d[size_t(pos)] = data[i];
+      data[i] = delayed;
+      pos = pos + 1 < alignSamples ? pos + 1 : 0;
+    }
+    alignPos[size_t(group)] = pos;
+  }
+
+  /** Impulse through up + down: DC group delay and decay length. */
+  void measureLatency() {
+    latencySamples = 0;
+    tailSamples = 0;
+    alignSamples = 0;
+    alignDelay.assign(size_t(numGroups), {});
+    alignPos.assign(size_t(numGroups), 0);
+
+    if (numStages == 0)
+      return;
+
+    const int length = std::min(maxSamples, 64);
+    const int numBlocks = 2048 / length + 1;
+    std::vector<SampleType> in(static_cast<size_t>(length), SampleType(0));
+    std::vector<SampleType> out(static_cast<size_t>(length), SampleType(0));
+    std::vector<double> response;
+    in[0] = SampleType(1);
+
+    // Measure on channel 0; prepare() resets its state afterwards
+    for (int b = 0; b < numBlocks; ++b) {
+      const SampleType *inPtr = in.data();
+      SampleType *outPtr = out.data();
+      processUp(&inPtr, 1, length);
+      processDown(&outPtr, 1, length);
+      response.insert(response.end(), out.begin(), out.end());
+      in[0] = SampleType(0);
+    }
+
+    double sum = 0.0, moment = 0.0, peak = 0.0;
+    for (size_t n = 0; n < response.size(); ++n) {
+      sum += response[n];
+      moment += double(n) * response[n];
+      peak = std::max(peak, std::abs(response[n]));
+    }
+
+    const double delay = sum != 0.0 ? moment / sum : 0.0;
+    const int factor = getFactor();
+    latencySamples = int(std::ceil(delay - 1.0e-6));
+    alignSamples = int(std::lround((latencySamples - delay) * factor));
+
+    for (size_t n = response.size(); n-- > 0;)
+      if (std::abs(response[n]) > peak * 1.0e-5) {
+        tailSamples = int(n) + 1;
+        break;
+      }
+
+    for (auto &d : alignDelay)
+      d.assign(size_t(std::max(alignSamples, 1)), Vector::zero());
+    std::fill(alignPos.begin(), alignPos.end(), 0);
+  }
+};
+
+} // namespace VT2RDSP
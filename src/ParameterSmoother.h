@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+    VT-2R - EMU AUDIO
+    Parameter Smoother
+
+    Linear parameter ramps handed out as whole segments instead of one value
+    per getNextValue() call.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+namespace VT2RDSP {
+
+//==============================================================================
+/**
+ * Linear ramp smoother (same timing as juce::SmoothedValue<Linear>).
+ *
+ * A settled smoother (isSmoothing() == false) lets the caller treat the
+ * whole block as constant. While ramping, advance() returns the next
+ * values as one linear segment that a vector loop can expand; the last
+ * ramp sample lands exactly on the target.
+ */
+template <typename SampleType> class RampSmoother {
+public:
+  /**
+   * Values for numSamples consecutive samples:
+   * value(i) = start + step * (i + 1) for i < rampLength, target after.
+   */
+  struct Segment {
+    SampleType start = 0;
+    SampleType step = 0;
+    SampleType target = 0;
+    int rampLength = 0;
+
+    SampleType operator[](int i) const {
+      return i < rampLength ? start + step * SampleType(i + 1) : target;
+    }
+  };
+
+  void reset(double sampleRate, double rampLengthSeconds) {
+    stepsToTarget = int(std::floor(rampLengthSeconds * sampleRate));
+    setCurrentAndTargetValue(target);
+  }
+
+  void setCurrentAndTargetValue(SampleType newValue) {
+    current = target = newValue;
+    countdown = 0;
+  }
+
+  void setTargetValue(SampleType newValue) {
+    if (newValue == target)
+      return;
+
+    if (stepsToTarget <= 0) {
+      setCurrentAndTargetValue(newValue);
+      return;
+    }
+
+    target = newValue;
+    countdown = stepsToTarget;
+    step = (target - current) / SampleType(countdown);
+  }
+
+  bool isSmoothing() const { return countdown > 0; }
+  SampleType getCurrentValue() const { return current; }
+  SampleType getTargetValue() const { return target; }
+
+  /** Consumes numSamples values and returns them as a segment. */
+  Segment advance(int numSamples) {
+    Segment segment;
+    segment.start = current;
+    segment.step = step;
+    segment.target = target;
+    // The countdown-th value is the target itself
+    segment.rampLength = std::clamp(countdown - 1, 0, numSamples);
+
+    if (numSamples >= countdown) {
+      current = target;
+      countdown = 0;
+    } else {
+      current = segment.start + step * SampleType(numSamples);
+      countdown -= numSamples;
+    }
+
+    return segment;
+  }
+
+  /** Consumes numSamples values into dest (vectorisable). */
+  void fill(SampleType *dest, int numSamples) {
+    const auto segment = advance(numSamples);
+
+    for (int i = 0; i < segment.rampLength; ++i)
+      dest[i] = segment.start + segment.step * SampleType(i + 1);
+    std::fill(dest + segment.rampLength, dest + numSamples, segment.target);
+  }
+
+private:
+  SampleType current = 0;
+  SampleType target = 0;
+  SampleType step = 0;
+  int countdown = 0;
+  int stepsToTarget = 0;
+};
+
+} // namespace VT2RDSP
@@ -10,6 +10,9 @@
 #include "PluginEditor.h"
 #include "BinaryData.h"
 #include "PluginProcessor.h"
+#include "TraceMarkers.h"
+
+#include <algorithm>
 
 // Debug Mode: 1=Layout Config, 0=Normal
 #define VT2B_DEBUG_MODE 0
@@ -23,43 +26,215 @@ static int g_debugMixY = 550;
 static int g_debugKnobSize = 250;
 #endif
 
+// Meters: refresh rate, range and ballistics
+namespace {
+constexpr int kMeterRefreshHz = 30;
+constexpr float kMeterFloorDb = -60.0f;
+constexpr float kMeterCeilingDb = 6.0f;
+constexpr float kPeakReleaseDbPerSecond = 20.0f;
+constexpr float kRmsTimeConstantSeconds = 0.3f;
+constexpr int kLoadRefreshTicks = kMeterRefreshHz / 2; // load text at 2 Hz
+} // namespace
+
+//==============================================================================
+// VT2BImageAssets Implementation
+//==============================================================================
+
+JUCE_IMPLEMENT_SINGLETON(VT2BImageAssets)
+
+VT2BImageAssets::VT2BImageAssets() {
+  for (int i = 0; i < BinaryData::namedResourceListSize; ++i) {
+    const auto *name = BinaryData::namedResourceList[i];
+    int size = 0;
+    const char *data = BinaryData::getNamedResource(name, size);
+
+    // Resource names are the file names: background_vt2rimg, ...
+    const juce::String resourceName(name);
+    Asset asset;
+    if (resourceName.startsWith("background_"))
+      asset = Asset::Background;
+    else if (resourceName.startsWith("knob_"))
+      asset = Asset::Knob;
+    else
+      continue;
+
+    // One bake per display scale, back to back
+    for (size_t offset = 0; offset < size_t(size);) {
+      Bake bake;
+      bake.data = data + offset;
+      bake.size = size_t(size) - offset;
+      if (!VT2RAssets::readHeader(bake.data, bake.size, bake.header))
+        break;
+
+      bake.size = bake.header.size;
+      offset += bake.size;
+      bakes[size_t(asset)].push_back(bake);
+    }
+  }
+
+  for (auto &assetBakes : bakes)
+    std::sort(assetBakes.begin(), assetBakes.end(),
+              [](const Bake &a, const Bake &b) {
+                return a.header.width < b.header.width;
+              });
+}
+
+VT2BImageAssets::~VT2BImageAssets() { clearSingletonInstance(); }
+
+juce::Rectangle<int> VT2BImageAssets::getLogicalBounds(Asset asset) const {
+  const auto &assetBakes = bakes[size_t(asset)];
+  if (assetBakes.empty())
+    return {};
+
+  const auto &header = assetBakes.front().header;
+  return {0, 0, header.logicalWidth, header.logicalHeight};
+}
+
+const juce::Image &VT2BImageAssets::find(Asset asset, int pixelWidth) {
+  static const juce::Image none;
+  auto &assetBakes = bakes[size_t(asset)];
+  if (assetBakes.empty())
+    return none;
+
+  auto *bake = &assetBakes.back();
+  for (auto &candidate : assetBakes)
+    if (candidate.header.width >= pixelWidth) {
+      bake = &candidate;
+      break;
+    }
+
+  if (bake->image.isNull())
+    bake->image = VT2RAssets::load(bake->data, bake->size);
+
+  return bake->image;
+}
+
+//==============================================================================
+// VT2BKnobFilmstrip Implementation
+//==============================================================================
+
+bool VT2BKnobFilmstrip::isValid() const {
+  return !VT2BImageAssets::getInstance()
+              ->getLogicalBounds(VT2BImageAssets::Asset::Knob)
+              .isEmpty();
+}
+
+void VT2BKnobFilmstrip::prepare(int pixelSize, float startAngleRadians,
+                                float endAngleRadians) {
+  if (pixelSize == framePixelSize && startAngleRadians == startAngle &&
+      endAngleRadians == endAngle && sourceImage.isValid())
+    return;
+
+  framePixelSize = pixelSize;
+  startAngle = startAngleRadians;
+  endAngle = endAngleRadians;
+
+  const auto side = size_t(juce::jmax(pixelSize, 1));
+  const auto frameBytes = side * side * 4; // ARGB
+  maxCachedFrames = juce::jlimit(kMinCachedFrames, kNumFrames,
+                                 int(kCacheBytes / frameBytes));
+  cache.clear();
+  cache.reserve(size_t(maxCachedFrames));
+
+  sourceImage = VT2BImageAssets::getInstance()->find(
+      VT2BImageAssets::Asset::Knob, pixelSize);
+}
+
+int VT2BKnobFilmstrip::getFrameIndex(double normalisedValue) {
+  return juce::jlimit(0, kNumFrames - 1,
+                      juce::roundToInt(normalisedValue * (kNumFrames - 1)));
+}
+
+const juce::Image &VT2BKnobFilmstrip::getFrame(int index) {
+  for (auto &frame : cache) {
+    if (frame.index == index) {
+      frame.lastUse = ++useCount;
+      return frame.image;
+    }
+  }
+
+  // Not cached: a free slot, or the least recently used frame's
+  if (int(cache.size()) < maxCachedFrames)
+    cache.emplace_back();
+
+  auto &frame = *std::min_element(
+      cache.begin(), cache.end(),
+      [](const CachedFrame &a, const CachedFrame &b) {
+        return a.lastUse < b.lastUse;
+      });
+
+  frame.index = index;
+  frame.image = renderFrame(index);
+  frame.lastUse = ++useCount;
+  return frame.image;
+}
+
+juce::Image VT2BKnobFilmstrip::renderFrame(int index) const {
+  juce::Image frame(juce::Image::ARGB, framePixelSize, framePixelSize, true);
+  juce::Graphics g(frame);
+  g.setImageResamplingQuality(juce::Graphics::highResamplingQuality);
+
+  const float proportion = float(index) / float(kNumFrames - 1);
+  const float angle = startAngle + proportion * (endAngle - startAngle);
+
+  const float imageWidth = static_cast<float>(sourceImage.getWidth());
+  const float imageHeight = static_cast<float>(sourceImage.getHeight());
+  const float scale = float(framePixelSize) / imageWidth;
+  const float centre = float(framePixelSize) / 2.0f;
+
+  juce::AffineTransform transform =
+      juce::AffineTransform::rotation(angle, imageWidth / 2.0f,
+                                      imageHeight / 2.0f)
+          .scaled(scale)
+          .translated(centre - (imageWidth * scale) / 2.0f,
+                      centre - (imageHeight * scale) / 2.0f);
+
+  g.drawImageTransformed(sourceImage, transform, false);
+  return frame;
+}
+
 //==============================================================================
 // VT2BImageKnob Implementation
 //==============================================================================
 
-VT2BImageKnob::VT2BImageKnob() { setRepaintsOnMouseActivity(true); }
+VT2BImageKnob::VT2BImageKnob()
+    : vBlankAttachment(this, [this] {
+        if (repaintPending) {
+          repaintPending = false;
+          repaint();
+        }
+      }) {}
 
 VT2BImageKnob::~VT2BImageKnob() {}
 
-void VT2BImageKnob::setImage(const juce::Image &image) {
-  knobImage = image;
+void VT2BImageKnob::setFilmstrip(VT2BKnobFilmstrip *knobFilmstrip) {
+  filmstrip = knobFilmstrip;
   repaint();
 }
 
+int VT2BImageKnob::getFrameIndex() const {
+  return VT2BKnobFilmstrip::getFrameIndex((value - minValue) /
+                                          (maxValue - minValue));
+}
+
 void VT2BImageKnob::paint(juce::Graphics &g) {
+  VT2R_TRACE_SCOPE("VT2BImageKnob::paint");
   auto bounds = getLocalBounds().toFloat();
-  auto centre = bounds.getCentre();
 
-  if (knobImage.isValid()) {
-    float normalizedValue =
-        static_cast<float>((value - minValue) / (maxValue - minValue));
-    float angle = startAngle + normalizedValue * (endAngle - startAngle);
+  if (filmstrip != nullptr && filmstrip->isValid()) {
+    // Frames are rendered at physical pixels, so drawing is a 1:1 blit
+    const float knobSize = juce::jmin(bounds.getWidth(), bounds.getHeight());
+    const float pixelScale =
+        g.getInternalContext().getPhysicalPixelScaleFactor();
 
-    float knobSize = juce::jmin(bounds.getWidth(), bounds.getHeight());
-    float scale = knobSize / static_cast<float>(knobImage.getWidth());
-
-    juce::AffineTransform transform =
-        juce::AffineTransform::rotation(
-            angle, static_cast<float>(knobImage.getWidth()) / 2.0f,
-            static_cast<float>(knobImage.getHeight()) / 2.0f)
-            .scaled(scale)
-            .translated(centre.x - (knobImage.getWidth() * scale) / 2.0f,
-                        centre.y - (knobImage.getHeight() * scale) / 2.0f);
-
-    g.drawImageTransformed(knobImage, transform, false);
+    filmstrip->prepare(juce::roundToInt(knobSize * pixelScale), startAngle,
+                       endAngle);
+    g.drawImage(filmstrip->getFrame(getFrameIndex()),
+                bounds.withSizeKeepingCentre(knobSize, knobSize));
   }
 
 #if VT2B_DEBUG_MODE
+  auto centre = bounds.getCentre();
   g.setColour(juce::Colours::red.withAlpha(0.5f));
   g.drawRect(getLocalBounds(), 2);
   g.setColour(juce::Colours::yellow);
@@ -78,8 +253,12 @@ void VT2BImageKnob::setRange(double min, double max, double interval) {
 
 void VT2BImageKnob::setValue(double newValue,
                              juce::NotificationType notification) {
+  const int previousFrame = getFrameIndex();
   value = juce::jlimit(minValue, maxValue, newValue);
-  repaint();
+
+  // Sub-frame changes look identical; real ones wait for the next vblank
+  if (getFrameIndex() != previousFrame)
+    repaintPending = true;
 
   if (notification != juce::dontSendNotification && onValueChange)
     onValueChange();
@@ -169,22 +348,146 @@ void VT2BImageKnob::mouseWheelMove(const juce::MouseEvent &,
   setValue(value + delta);
 }
 
+//==============================================================================
+// VT2BLevelMeter Implementation
+//==============================================================================
+
+VT2BLevelMeter::VT2BLevelMeter() { setInterceptsMouseClicks(false, false); }
+
+VT2BLevelMeter::~VT2BLevelMeter() {}
+
+void VT2BLevelMeter::setScale(Scale newScale) {
+  scale = newScale;
+  repaint();
+}
+
+void VT2BLevelMeter::setLabel(const juce::String &labelText) {
+  label = labelText;
+  repaint();
+}
+
+void VT2BLevelMeter::update(float blockPeak, float blockRms, float seconds) {
+  const float previousPeak = peak;
+  const float previousRms = rms;
+
+  // Peak: instant attack, constant dB/s release
+  const float release =
+      juce::Decibels::decibelsToGain(-kPeakReleaseDbPerSecond * seconds);
+  peak = juce::jmax(blockPeak, peak * release);
+
+  // RMS: one-pole average
+  rms += (blockRms - rms) *
+         (1.0f - std::exp(-seconds / kRmsTimeConstantSeconds));
+
+  // Settled at the bottom of the scale: nothing to redraw
+  if (toProportion(peak) != toProportion(previousPeak) ||
+      toProportion(rms) != toProportion(previousRms))
+    repaint();
+}
+
+float VT2BLevelMeter::toProportion(float level) const {
+  if (scale == Scale::Amount)
+    return juce::jlimit(0.0f, 1.0f, level);
+
+  const float db = juce::Decibels::gainToDecibels(level, kMeterFloorDb);
+  return juce::jlimit(0.0f, 1.0f,
+                      (db - kMeterFloorDb) / (kMeterCeilingDb - kMeterFloorDb));
+}
+
+void VT2BLevelMeter::paint(juce::Graphics &g) {
+  auto bounds = getLocalBounds().toFloat();
+  auto labelArea = bounds.removeFromBottom(14.0f);
+
+  g.setColour(juce::Colours::black.withAlpha(0.6f));
+  g.fillRoundedRectangle(bounds, 2.0f);
+
+  const auto bar = bounds.reduced(2.0f);
+  const auto colour = scale == Scale::Amount ? juce::Colour(0xffe0a030)
+                                             : juce::Colour(0xff50c070);
+
+  // RMS bar
+  const float rmsHeight = bar.getHeight() * toProportion(rms);
+  g.setColour(colour);
+  g.fillRect(bar.withTop(bar.getBottom() - rmsHeight));
+
+  // Peak line (red above 0 dBFS)
+  const float peakProportion = toProportion(peak);
+  if (peakProportion > 0.0f) {
+    const bool over = scale == Scale::Decibels && peak > 1.0f;
+    g.setColour(over ? juce::Colours::red : colour.brighter(0.5f));
+    g.fillRect(bar.getX(), bar.getBottom() - bar.getHeight() * peakProportion,
+               bar.getWidth(), 2.0f);
+  }
+
+  g.setColour(juce::Colours::white.withAlpha(0.8f));
+  g.setFont(11.0f);
+  g.drawText(label, labelArea, juce::Justification::centred);
+}
+
+//==============================================================================
+// VT2BLoadDisplay Implementation
+//==============================================================================
+
+VT2BLoadDisplay::VT2BLoadDisplay() {
+  // Click copies the full report
+  setMouseCursor(juce::MouseCursor::PointingHandCursor);
+}
+
+VT2BLoadDisplay::~VT2BLoadDisplay() {}
+
+void VT2BLoadDisplay::setSnapshot(
+    const VT2RDSP::AudioThreadWatchdog::Snapshot &snapshot) {
+  juce::String newText;
+  newText << "DSP " << juce::roundToInt(snapshot.meanLoad * 100.0) << "% avg  "
+          << juce::roundToInt(snapshot.worstLoad * 100.0) << "% max  "
+          << juce::String(snapshot.numOverruns) << " over";
+
+  if (VT2RDSP::RealtimeSafety::kInstrumented)
+    newText << "  " << juce::String(snapshot.heapOperations) << " alloc  "
+            << juce::String(snapshot.blockingCalls) << " lock";
+
+  const bool newWarning = snapshot.numOverruns > 0 ||
+                          snapshot.heapOperations > 0 ||
+                          snapshot.blockingCalls > 0;
+
+  if (newText != text || newWarning != warning) {
+    text = newText;
+    warning = newWarning;
+    repaint();
+  }
+}
+
+void VT2BLoadDisplay::paint(juce::Graphics &g) {
+  g.setColour(warning ? juce::Colours::orange
+                      : juce::Colours::white.withAlpha(0.6f));
+  g.setFont(11.0f);
+  g.drawText(text, getLocalBounds(), juce::Justification::centredLeft);
+}
+
+void VT2BLoadDisplay::mouseUp(const juce::MouseEvent &) {
+  if (onClick)
+    onClick();
+}
+
 //==============================================================================
 // VT2BBlackEditor Implementation
 //==============================================================================
 
 VT2BBlackEditor::VT2BBlackEditor(VT2BBlackProcessor &p)
     : AudioProcessorEditor(&p), audioProcessor(p) {
-  loadImages();
+  // The background covers the editor: nothing behind it needs painting
+  setOpaque(true);
 
   // Set Size to match Background (1024x866)
-  if (backgroundImage.isValid())
-    setSize(backgroundImage.getWidth(), backgroundImage.getHeight());
+  const auto background = VT2BImageAssets::getInstance()->getLogicalBounds(
+      VT2BImageAssets::Asset::Background);
+  if (!background.isEmpty())
+    setSize(background.getWidth(), background.getHeight());
   else
     setSize(1024, 866);
 
   // Drive Knob
-  driveKnob.setImage(knobImage);
+  driveKnob.setFilmstrip(&knobFilmstrip);
   driveKnob.setLabel("DRIVE");
   driveKnob.setRange(0.0, 100.0, 0.1);
   driveKnob.setValue(0.0);
@@ -192,13 +495,26 @@ VT2BBlackEditor::VT2BBlackEditor(VT2BBlackProcessor &p)
   addAndMakeVisible(driveKnob);
 
   // Mix Knob
-  mixKnob.setImage(knobImage);
+  mixKnob.setFilmstrip(&knobFilmstrip);
   mixKnob.setLabel("MIX");
   mixKnob.setRange(0.0, 100.0, 1.0);
   mixKnob.setValue(100.0);
   mixKnob.setRotationRange(-2.35619f, 2.35619f);
   addAndMakeVisible(mixKnob);
 
+  // Meters
+  inputMeter.setLabel("IN");
+  outputMeter.setLabel("OUT");
+  saturationMeter.setLabel("SAT");
+  saturationMeter.setScale(VT2BLevelMeter::Scale::Amount);
+  addAndMakeVisible(inputMeter);
+  addAndMakeVisible(outputMeter);
+  addAndMakeVisible(saturationMeter);
+
+  // Audio thread load
+  loadDisplay.onClick = [this]() { dumpWatchdogReport(); };
+  addAndMakeVisible(loadDisplay);
+
   // Internal Sliders for Attachment
   // Both now 0-100 to match Processor
   driveSlider.setRange(0.0, 100.0);
@@ -226,24 +542,77 @@ VT2BBlackEditor::VT2BBlackEditor(VT2BBlackProcessor &p)
   mixAttachment =
       std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
           audioProcessor.getParameters(), "mix", mixSlider);
+
+  // Metering runs only while the editor exists; drop frames left over from
+  // a previous editor before turning it on
+  VT2RDSP::MeterFrame staleFrame;
+  while (audioProcessor.popMeterFrame(staleFrame)) {
+  }
+
+  audioProcessor.setMeteringEnabled(true);
+  startTimerHz(kMeterRefreshHz);
 }
 
 VT2BBlackEditor::~VT2BBlackEditor() {
+  stopTimer();
+  audioProcessor.setMeteringEnabled(false);
+
   driveAttachment.reset();
   mixAttachment.reset();
 }
 
-void VT2BBlackEditor::loadImages() {
-  backgroundImage = juce::ImageCache::getFromMemory(
-      BinaryData::background_png, BinaryData::background_pngSize);
+void VT2BBlackEditor::timerCallback() {
+  // Maxima of every block since the last tick
+  VT2RDSP::MeterFrame frame, levels;
+  while (audioProcessor.popMeterFrame(frame)) {
+    levels.inputPeak = juce::jmax(levels.inputPeak, frame.inputPeak);
+    levels.inputRms = juce::jmax(levels.inputRms, frame.inputRms);
+    levels.outputPeak = juce::jmax(levels.outputPeak, frame.outputPeak);
+    levels.outputRms = juce::jmax(levels.outputRms, frame.outputRms);
+    levels.saturation = juce::jmax(levels.saturation, frame.saturation);
+  }
+
+  const float seconds = float(getTimerInterval()) * 0.001f;
+  inputMeter.update(levels.inputPeak, levels.inputRms, seconds);
+  outputMeter.update(levels.outputPeak, levels.outputRms, seconds);
+  saturationMeter.update(levels.saturation, levels.saturation, seconds);
+
+  if (--ticksUntilLoadUpdate <= 0) {
+    ticksUntilLoadUpdate = kLoadRefreshTicks;
+    loadDisplay.setSnapshot(audioProcessor.getWatchdog().getSnapshot());
+  }
+}
 
-  knobImage = juce::ImageCache::getFromMemory(BinaryData::knob_png,
-                                              BinaryData::knob_pngSize);
+void VT2BBlackEditor::dumpWatchdogReport() {
+  const auto report = audioProcessor.createWatchdogReport();
+  juce::SystemClipboard::copyTextToClipboard(report);
+  juce::Logger::writeToLog(report);
 }
 
 void VT2BBlackEditor::paint(juce::Graphics &g) {
-  if (backgroundImage.isValid()) {
-    g.drawImage(backgroundImage, getLocalBounds().toFloat());
+  VT2R_TRACE_SCOPE("VT2BBlackEditor::paint");
+  const float pixelScale = g.getInternalContext().getPhysicalPixelScaleFactor();
+  const int width = juce::roundToInt(float(getWidth()) * pixelScale);
+  const int height = juce::roundToInt(float(getHeight()) * pixelScale);
+
+  const auto &background = VT2BImageAssets::getInstance()->find(
+      VT2BImageAssets::Asset::Background, width);
+
+  if (background.isValid()) {
+    // Baked for this display scale: blitted 1:1. Other scales are rescaled
+    // once per size from the nearest larger bake (or the largest: bakes
+    // stop at the PNG's resolution), then blitted.
+    const auto *image = &background;
+
+    if (image->getWidth() != width || image->getHeight() != height) {
+      if (scaledBackground.getWidth() != width ||
+          scaledBackground.getHeight() != height)
+        scaledBackground = image->rescaled(
+            width, height, juce::Graphics::highResamplingQuality);
+      image = &scaledBackground;
+    }
+
+    g.drawImage(*image, getLocalBounds().toFloat());
   } else {
     g.fillAll(juce::Colour(0xff881111)); // Red fallback
   }
@@ -276,4 +645,17 @@ void VT2BBlackEditor::resized() {
   // MIX knob (center at 809, 626)
   mixKnob.setBounds(809 - knobSize / 2, 626 - knobSize / 2, knobSize, knobSize);
 #endif
+
+  // Meters: IN / OUT / SAT side by side, centred between the knobs
+  const int meterWidth = 16;
+  const int meterGap = 12;
+  const int meterHeight = 180;
+  int meterX = getWidth() / 2 - (3 * meterWidth + 2 * meterGap) / 2;
+
+  for (auto *meter : {&inputMeter, &outputMeter, &saturationMeter}) {
+    meter->setBounds(meterX, 626 - meterHeight / 2, meterWidth, meterHeight);
+    meterX += meterWidth + meterGap;
+  }
+
+  loadDisplay.setBounds(12, 8, 320, 16);
 }
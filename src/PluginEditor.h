@@ -9,14 +9,111 @@
 
 #pragma once
 
+#include "BakedImage.h"
 #include "PluginProcessor.h"
 
 // デバッグモード
 #define VT2B_DEBUG_MODE 0
 
+//==============================================================================
+/**
+ * 画像アセット（ビルド時に変換済み）
+ *
+ * The background and knob images baked into the binary data at every
+ * display scale in VT2R_IMAGE_SCALES (see BakedImage.h). Only the headers
+ * are read up front; a scale's pixels are inflated into a juce::Image the
+ * first time it is drawn and kept until the plugin is unloaded, so opening
+ * an editor never decodes a PNG or resamples, and reopening copies
+ * nothing.
+ * Message thread only.
+ */
+class VT2BImageAssets : private juce::DeletedAtShutdown {
+public:
+  enum class Asset { Background = 0, Knob, NumAssets };
+
+  ~VT2BImageAssets() override;
+
+  /** Component size the asset was baked for (0 x 0 if it is missing). */
+  juce::Rectangle<int> getLogicalBounds(Asset asset) const;
+
+  /**
+   * The image baked at pixelWidth, else the smallest wider one (to be
+   * reduced), else the widest. Null if the asset is missing.
+   */
+  const juce::Image &find(Asset asset, int pixelWidth);
+
+  JUCE_DECLARE_SINGLETON_SINGLETHREADED_MINIMAL(VT2BImageAssets)
+
+private:
+  VT2BImageAssets();
+
+  struct Bake {
+    const void *data = nullptr;
+    size_t size = 0;
+    VT2RAssets::Header header;
+    juce::Image image; // null = not loaded yet
+  };
+
+  std::vector<Bake> bakes[size_t(Asset::NumAssets)]; // ascending width
+};
+
+//==============================================================================
+/**
+ * ノブ画像の回転フィルムストリップ（キャッシュ）
+ *
+ * kNumFrames rotations of the knob image, rendered at the physical pixel
+ * size the knob is displayed at, on first use. Only the most recently used
+ * frames are kept, within kCacheBytes (but at least kMinCachedFrames, one
+ * per knob plus a neighbour each): the 206 px knob keeps 24 frames (3.9 MB)
+ * at 1x and 6 frames (3.9 MB) at 2x, instead of 22 / 87 MB for all 128. An
+ * automation sweep renders each new angle once (one transformed draw) and
+ * evicts the least recently used. Shared by every knob that uses the same
+ * image. Each size renders from the knob image baked closest to it, which
+ * at the baked scales needs no scaling.
+ */
+class VT2BKnobFilmstrip {
+public:
+  static constexpr int kNumFrames = 128;
+  static constexpr size_t kCacheBytes = 4 << 20;
+  static constexpr int kMinCachedFrames = 4;
+
+  bool isValid() const;
+
+  /** Drops the cached frames if the pixel size or rotation range changed. */
+  void prepare(int pixelSize, float startAngleRadians, float endAngleRadians);
+
+  /**
+   * Frame for a getFrameIndex() index, rendered if it is not cached. Valid
+   * until the next call (draw it straight away).
+   */
+  const juce::Image &getFrame(int index);
+  static int getFrameIndex(double normalisedValue);
+
+private:
+  juce::Image renderFrame(int index) const;
+
+  struct CachedFrame {
+    int index = -1;
+    juce::Image image;
+    juce::uint32 lastUse = 0;
+  };
+
+  juce::Image sourceImage; // baked knob for the current frame size
+  std::vector<CachedFrame> cache; // up to maxCachedFrames
+  int maxCachedFrames = kMinCachedFrames;
+  juce::uint32 useCount = 0;
+
+  int framePixelSize = 0;
+  float startAngle = 0.0f;
+  float endAngle = 0.0f;
+};
+
 //==============================================================================
 /**
  * 画像ベースのノブ - 回転するゴールドノブ
+ *
+ * Draws a cached filmstrip frame; value changes repaint only when the frame
+ * changes, at most once per display refresh.
  */
 class VT2BImageKnob : public juce::Component {
 public:
@@ -26,7 +123,7 @@ public:
   void paint(juce::Graphics &g) override;
   void resized() override;
 
-  void setImage(const juce::Image &knobImage);
+  void setFilmstrip(VT2BKnobFilmstrip *knobFilmstrip);
   void setRange(double min, double max, double interval = 0.0);
   void
   setValue(double newValue,
@@ -46,7 +143,13 @@ private:
   void mouseWheelMove(const juce::MouseEvent &event,
                       const juce::MouseWheelDetails &wheel) override;
 
-  juce::Image knobImage;
+  int getFrameIndex() const;
+
+  VT2BKnobFilmstrip *filmstrip = nullptr; // owned by the editor
+
+  // Repaints are coalesced to the display refresh
+  bool repaintPending = false;
+  juce::VBlankAttachment vBlankAttachment;
 
   double value = 0.0;
   double minValue = 0.0;
@@ -69,11 +172,74 @@ private:
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VT2BImageKnob)
 };
 
+//==============================================================================
+/**
+ * バーメーター - ピーク（線）+ RMS（バー）
+ *
+ * update() applies the ballistics once per UI tick: instant attack, peak
+ * released at a fixed dB/s, RMS averaged. Levels are linear gain (shown
+ * in dB) or, for the saturation meter, an amount 0-1.
+ */
+class VT2BLevelMeter : public juce::Component {
+public:
+  enum class Scale { Decibels, Amount };
+
+  VT2BLevelMeter();
+  ~VT2BLevelMeter() override;
+
+  void paint(juce::Graphics &g) override;
+
+  void setScale(Scale newScale);
+  void setLabel(const juce::String &labelText);
+
+  /** Maxima of the blocks since the last tick; seconds = tick interval. */
+  void update(float blockPeak, float blockRms, float seconds);
+
+private:
+  float toProportion(float level) const;
+
+  Scale scale = Scale::Decibels;
+  juce::String label;
+
+  float peak = 0.0f;
+  float rms = 0.0f;
+
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VT2BLevelMeter)
+};
+
+//==============================================================================
+/**
+ * オーディオスレッド負荷表示 (AudioThreadWatchdog)
+ *
+ * One line of text: mean / worst block load, overruns and, in instrumented
+ * builds, RT-safety violations. Clicking it calls onClick (report dump).
+ */
+class VT2BLoadDisplay : public juce::Component {
+public:
+  VT2BLoadDisplay();
+  ~VT2BLoadDisplay() override;
+
+  void paint(juce::Graphics &g) override;
+
+  void setSnapshot(const VT2RDSP::AudioThreadWatchdog::Snapshot &snapshot);
+
+  std::function<void()> onClick;
+
+private:
+  void mouseUp(const juce::MouseEvent &event) override;
+
+  juce::String text;
+  bool warning = false; // overruns or RT-safety violations seen
+
+  JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VT2BLoadDisplay)
+};
+
 //==============================================================================
 /**
  * メインエディター - 背景画像とノブ画像を使用
  */
-class VT2BBlackEditor : public juce::AudioProcessorEditor {
+class VT2BBlackEditor : public juce::AudioProcessorEditor,
+                        private juce::Timer {
 public:
   explicit VT2BBlackEditor(VT2BBlackProcessor &);
   ~VT2BBlackEditor() override;
@@ -85,14 +251,25 @@ public:
 private:
   VT2BBlackProcessor &audioProcessor;
 
-  // 画像
-  juce::Image backgroundImage;
-  juce::Image knobImage;
+  // Render cache: background at the current size and display scale when it
+  // is not one of the baked scales, and the knob rotations shared by both
+  // knobs
+  juce::Image scaledBackground;
+  VT2BKnobFilmstrip knobFilmstrip;
 
   // ノブ
   VT2BImageKnob driveKnob;
   VT2BImageKnob mixKnob;
 
+  // メーター (IN / OUT / SAT)
+  VT2BLevelMeter inputMeter;
+  VT2BLevelMeter outputMeter;
+  VT2BLevelMeter saturationMeter;
+
+  // Audio thread load (click: copy the full report)
+  VT2BLoadDisplay loadDisplay;
+  int ticksUntilLoadUpdate = 0;
+
   // 内部スライダー（アタッチメント用）
   juce::Slider driveSlider;
   juce::Slider mixSlider;
@@ -103,8 +280,11 @@ private:
   std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment>
       mixAttachment;
 
-  // 画像ロード
-  void loadImages();
+  // Drains the processor's meter FIFO into the meters; refreshes the load
+  void timerCallback() override;
+
+  // Watchdog report -> clipboard and log
+  void dumpWatchdogReport();
 
   JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VT2BBlackEditor)
 };
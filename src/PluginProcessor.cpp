@@ -12,32 +12,43 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "TraceMarkers.h"
+#include "VT2RConstants.h"
 #include <cmath>
 
-//==============================================================================
-// Constants for VT-2R
-namespace VT2RConstants {
-// Drive Range
-constexpr float kDriveMin = 0.0f;
-constexpr float kDriveMax = 100.0f; // User sees 0-100
-constexpr float kDriveDefault = 0.0f;
-
-// Mix Range
-constexpr float kMixMin = 0.0f;
-constexpr float kMixMax = 100.0f;
-constexpr float kMixDefault = 100.0f;
-
-// DSP Constants
-constexpr float kPreEmphasisFreq = 2000.0f; // 2kHz
-constexpr float kPreEmphasisQ = 0.7f;
-constexpr float kMaxPreEmphasisGainDb = 9.0f; // Boost mids up to 9dB
-
-// Saturation Curve
-// Higher drive = steeper curve
-constexpr float kSaturationSteepnessBase = 1.0f;
-constexpr float kSaturationSteepnessMax = 5.0f;
-
-} // namespace VT2RConstants
+namespace {
+
+/** Largest per-channel RMS of the first numChannels channels. */
+template <typename SampleType>
+SampleType getMaxRmsLevel(const juce::AudioBuffer<SampleType> &buffer,
+                          int numChannels) {
+  SampleType rms = 0;
+  for (int ch = 0; ch < numChannels; ++ch)
+    rms = juce::jmax(rms, buffer.getRMSLevel(ch, 0, buffer.getNumSamples()));
+  return rms;
+}
+
+/**
+ * Largest saturator input the lane kernels saw since the last call (every
+ * lane of every group; unused lanes stay 0), clearing it for the next.
+ */
+template <typename SampleType>
+SampleType
+takeDrivenPeak(std::vector<VT2RDSP::LaneFilterState<SampleType>> &states) {
+  using V = VT2RDSP::SIMDRegister<SampleType>;
+  alignas(V::kAlignment) SampleType lanes[V::kNumLanes];
+
+  SampleType peak = 0;
+  for (auto &state : states) {
+    state.drivenPeak.store(lanes);
+    for (const auto lane : lanes)
+      peak = juce::jmax(peak, lane);
+    state.drivenPeak = V::zero();
+  }
+  return peak;
+}
+
+} // namespace
 
 //==============================================================================
 VT2BBlackProcessor::VT2BBlackProcessor()
@@ -49,9 +60,33 @@ VT2BBlackProcessor::VT2BBlackProcessor()
                  createParameterLayout()) {
   driveParameter = parameters.getRawParameterValue("drive");
   mixParameter = parameters.getRawParameterValue("mix");
+  qualityParameter = parameters.getRawParameterValue("quality");
+  oversamplingParameter = parameters.getRawParameterValue("oversampling");
+  oversamplingFilterParameter =
+      parameters.getRawParameterValue("oversamplingFilter");
+  antialiasingParameter = parameters.getRawParameterValue("antialiasing");
+  characterParameter = parameters.getRawParameterValue("character");
+
+  for (int i = 0; i < VT2RState::kNumFields; ++i) {
+    const auto *id = VT2RState::kParameterIds[i];
+    stateParameters[size_t(i)] = parameters.getParameter(id);
+    stateValues[size_t(i)] = parameters.getRawParameterValue(id);
+    jassert(stateParameters[size_t(i)] != nullptr);
+  }
+
+  parameters.addParameterListener("oversampling", this);
+  parameters.addParameterListener("oversamplingFilter", this);
+  parameters.addParameterListener("antialiasing", this);
+  parameters.addParameterListener("character", this);
 }
 
-VT2BBlackProcessor::~VT2BBlackProcessor() {}
+VT2BBlackProcessor::~VT2BBlackProcessor() {
+  parameters.removeParameterListener("oversampling", this);
+  parameters.removeParameterListener("oversamplingFilter", this);
+  parameters.removeParameterListener("antialiasing", this);
+  parameters.removeParameterListener("character", this);
+  cancelPendingUpdate();
+}
 
 //==============================================================================
 juce::AudioProcessorValueTreeState::ParameterLayout
@@ -74,6 +109,41 @@ VT2BBlackProcessor::createParameterLayout() {
       VT2RConstants::kMixDefault,
       juce::AudioParameterFloatAttributes().withLabel("%")));
 
+  // Saturator accuracy (Eco / Normal / Precise)
+  params.push_back(std::make_unique<juce::AudioParameterChoice>(
+      juce::ParameterID{"quality", 1}, "Quality",
+      juce::StringArray{"Eco", "Normal", "Precise"},
+      VT2RConstants::kQualityDefault));
+
+  // Oversampling around the nonlinear stages (changes the latency)
+  params.push_back(std::make_unique<juce::AudioParameterChoice>(
+      juce::ParameterID{"oversampling", 1}, "Oversampling",
+      juce::StringArray{"Off", "2x", "4x", "8x"},
+      VT2RConstants::kOversamplingDefault,
+      juce::AudioParameterChoiceAttributes().withAutomatable(false)));
+
+  params.push_back(std::make_unique<juce::AudioParameterChoice>(
+      juce::ParameterID{"oversamplingFilter", 1}, "Oversampling Filter",
+      juce::StringArray{"Minimum Phase", "Linear Phase"}, 0,
+      juce::AudioParameterChoiceAttributes().withAutomatable(false)));
+
+  // ADAA saturator: anti-aliasing without (or on top of) oversampling.
+  // Switches the saturator's history, so not automatable either. Sessions
+  // saved with the former "ADAA 2nd Order" (index 2) load as 1st order.
+  params.push_back(std::make_unique<juce::AudioParameterChoice>(
+      juce::ParameterID{"antialiasing", 1}, "Anti-Aliasing",
+      juce::StringArray{"Off", "ADAA 1st Order"},
+      VT2RConstants::kAntialiasingDefault,
+      juce::AudioParameterChoiceAttributes().withAutomatable(false)));
+
+  // Wet path character: the original chain, or with the DSP_DESIGN glue
+  // stages. Changes the tail and restarts the glue filters - not automatable.
+  params.push_back(std::make_unique<juce::AudioParameterChoice>(
+      juce::ParameterID{"character", 1}, "Character",
+      juce::StringArray{"Aggressive", "Glue"},
+      VT2RConstants::kCharacterDefault,
+      juce::AudioParameterChoiceAttributes().withAutomatable(false)));
+
   return {params.begin(), params.end()};
 }
 
@@ -85,7 +155,9 @@ const juce::String VT2BBlackProcessor::getName() const {
 bool VT2BBlackProcessor::acceptsMidi() const { return false; }
 bool VT2BBlackProcessor::producesMidi() const { return false; }
 bool VT2BBlackProcessor::isMidiEffect() const { return false; }
-double VT2BBlackProcessor::getTailLengthSeconds() const { return 0.0; }
+double VT2BBlackProcessor::getTailLengthSeconds() const {
+  return tailLengthSeconds;
+}
 
 int VT2BBlackProcessor::getNumPrograms() { return 1; }
 int VT2BBlackProcessor::getCurrentProgram() { return 0; }
@@ -95,185 +167,768 @@ void VT2BBlackProcessor::changeProgramName(int, const juce::String &) {}
 
 //==============================================================================
 void VT2BBlackProcessor::prepareToPlay(double sampleRate, int samplesPerBlock) {
+  VT2R_TRACE_SCOPE("prepareToPlay");
   currentSampleRate = sampleRate;
+  preparedBlockSize = juce::jmax(samplesPerBlock, 1);
+
+  // Build the shared saturation LUT off the audio thread
+  VT2RDSP::TanhTable::getTable();
+
+  // Hosts set the precision before prepareToPlay; the unused engine is
+  // released so switching precision never keeps both allocated
+  if (isUsingDoublePrecision()) {
+    prepareEngine(doubleEngine);
+    floatEngine = Engine<float>();
+  } else {
+    prepareEngine(floatEngine);
+    doubleEngine = Engine<double>();
+  }
+
+  prepareOfflineWorkers(isUsingDoublePrecision()
+                            ? doubleEngine.oversampler.getNumGroups()
+                            : floatEngine.oversampler.getNumGroups());
 
-  smoothedDrive.reset(sampleRate, 0.02); // 20ms smoothing
-  smoothedMix.reset(sampleRate, 0.02);
+  // Load statistics per playback configuration
+  watchdog.reset();
+}
+
+void VT2BBlackProcessor::prepareOfflineWorkers(int numGroups) {
+  // Held whatever the render mode: the AU wrapper (and other hosts) switch
+  // setNonRealtime without preparing again, and the shared pool's threads
+  // only run while some instance renders offline
+  if (numGroups > 1) {
+    if (offlineWorkers == nullptr)
+      offlineWorkers = VT2RDSP::WorkerPool::getShared();
+  } else {
+    offlineWorkers.reset();
+  }
+}
+
+template <typename SampleType>
+void VT2BBlackProcessor::prepareEngine(Engine<SampleType> &engine) {
+  engine.smoothedDrive.reset(currentSampleRate, 0.02); // 20ms smoothing
+  engine.smoothedMix.reset(currentSampleRate, 0.02);
+
+  // Start at the current settings rather than ramping in from the last target
+  engine.smoothedDrive.setCurrentAndTargetValue(
+      SampleType(driveParameter->load()));
+  engine.smoothedMix.setCurrentAndTargetValue(
+      SampleType(mixParameter->load()) / SampleType(100));
+
+  // Oversampler, pre-emphasis table and dry delay for the current settings
+  prepareOversampling(engine);
+}
+
+template <typename SampleType>
+void VT2BBlackProcessor::prepareOversampling(Engine<SampleType> &engine) {
+  // Processed channels (mono -> stereo: one, copied to the second output)
+  const int numChannels = juce::jmax(
+      juce::jmin(getTotalNumInputChannels(), getTotalNumOutputChannels()), 1);
+  const int numStages = juce::roundToInt(oversamplingParameter->load());
+  const auto filter = static_cast<VT2RDSP::OversamplingFilter>(
+      juce::roundToInt(oversamplingFilterParameter->load()));
+
+  // Buffers for the offline chunk in either render mode, so a host may
+  // switch (setNonRealtime) without preparing again; realtime chunks use
+  // one sub-block of them. Lane buffers only ever hold one sub-block.
+  const int chunkSubBlocks = VT2RConstants::kOfflineChunkSubBlocks;
+  engine.maxChunkSamples = chunkSubBlocks * VT2RConstants::kSubBlockSize;
+  engine.subBlockPhase = 0;
+
+  auto &oversampler = engine.oversampler;
+  oversampler.prepare(numStages, filter, numChannels,
+                      VT2RConstants::kSubBlockSize);
+  const int factor = oversampler.getFactor();
+
+  // Pre-Emphasis coefficient table for the (oversampled) processing rate
+  engine.preEmphasisTable = VT2RDSP::PreEmphasisTable<SampleType>::getShared(
+      currentSampleRate * factor);
+  engine.preEmphasisDrive = engine.smoothedDrive.getCurrentValue();
+  engine.preEmphasisCoeffs =
+      engine.preEmphasisTable->lookup(engine.preEmphasisDrive);
+
+  // Glue stage coefficients, also at the processing rate
+  engine.character = static_cast<VT2RDSP::Character>(
+      juce::roundToInt(characterParameter->load()));
+  engine.glueCoeffs.prepare(currentSampleRate * factor);
+
+  // Working buffers: one chunk, whatever the host's buffer size
+  const auto chunkSamples = size_t(engine.maxChunkSamples);
+  engine.wetBuffer.setSize(numChannels, engine.maxChunkSamples);
+  engine.mixGains.assign(chunkSamples, SampleType(0));
+  engine.rampInputGain.assign(chunkSamples, SampleType(0));
+  engine.rampMakeupGain.assign(chunkSamples, SampleType(0));
+  engine.rampNormDrive.assign(chunkSamples, SampleType(0));
+  engine.rampCoeffs.resize(chunkSamples /
+                           VT2RConstants::kCoefficientUpdateInterval);
+  engine.subBlocks.resize(size_t(chunkSubBlocks));
+  engine.chunkChannels.assign(size_t(numChannels), nullptr);
+  engine.groupInputs.assign(size_t(numChannels), nullptr);
+  engine.groupOutputs.assign(size_t(numChannels), nullptr);
+
+  // ADAA delays the wet path by half a sample at the processing rate (not
+  // compensated)
+  engine.antialiasing = static_cast<VT2RDSP::Antialiasing>(
+      juce::roundToInt(antialiasingParameter->load()));
+
+  // Dry path delayed by the oversampling latency so Mix stays phase
+  // aligned. The minimum phase filters' group delay varies with frequency,
+  // which no delay line matches: the dry path goes through a copy of the
+  // filters instead.
+  const int latency = oversampler.getLatencySamples();
+  engine.filterDryPath =
+      numStages > 0 && filter == VT2RDSP::OversamplingFilter::MinimumPhase;
+  engine.dryFilterRunning = false;
+  if (engine.filterDryPath)
+    engine.dryOversampler.prepare(numStages, filter, numChannels,
+                                  VT2RConstants::kSubBlockSize);
+  else
+    engine.dryOversampler = VT2RDSP::Oversampler<SampleType>();
+
+  engine.dryDelaySamples = engine.filterDryPath ? 0 : latency;
+  engine.dryDelayBuffer.setSize(numChannels,
+                                juce::jmax(engine.dryDelaySamples, 1));
+  engine.dryDelayBuffer.clear();
+  engine.dryDelayPosition = 0;
 
   // Reset Filter States
-  midBoostStateL = {0, 0};
-  midBoostStateR = {0, 0};
-  lastInL = 0;
-  lastInR = 0;
+  const auto numGroups = size_t(oversampler.getNumGroups());
+  engine.laneFilterStates.assign(numGroups, {});
+  engine.adaa1States.assign(
+      engine.antialiasing == VT2RDSP::Antialiasing::FirstOrder ? numGroups : 0,
+      {});
+  engine.glueStates.assign(numGroups, {});
+  engine.wetPathRunning = true;
+  engine.preEmphasisRunning = true;
+
+  setLatencySamples(latency);
+  const double glueTailSamples =
+      engine.character == VT2RDSP::Character::Glue
+          ? engine.glueCoeffs.getTailSamples()
+          : 0.0;
+  tailLengthSeconds =
+      (oversampler.getTailSamples() +
+       (engine.preEmphasisTable->getTailSamples() + glueTailSamples) /
+           factor) /
+      currentSampleRate;
+
+  // Silence idles only once the tail (and the dry delay) has run out
+  engine.idleAfterSamples = juce::jmax(
+      int(std::ceil(tailLengthSeconds * currentSampleRate)), latency);
+  engine.silentSamples = 0;
+}
+
+void VT2BBlackProcessor::parameterChanged(const juce::String &, float) {
+  // Oversampling / anti-aliasing / character changes reallocate - never on
+  // the audio thread
+  triggerAsyncUpdate();
+}
+
+void VT2BBlackProcessor::handleAsyncUpdate() {
+  if (preparedBlockSize == 0)
+    return; // Not prepared yet - prepareToPlay picks up the settings
+
+  suspendProcessing(true);
+  if (isUsingDoublePrecision())
+    prepareOversampling(doubleEngine);
+  else
+    prepareOversampling(floatEngine);
+  suspendProcessing(false);
 }
 
 void VT2BBlackProcessor::releaseResources() {}
 
 bool VT2BBlackProcessor::isBusesLayoutSupported(
     const BusesLayout &layouts) const {
-  if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono() &&
-      layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
-    return false;
+  // Any channel count (mono ... 7.1.4 / Atmos beds); channels are processed
+  // as independent SIMD lanes
+  const auto &input = layouts.getMainInputChannelSet();
+  const auto &output = layouts.getMainOutputChannelSet();
 
-  if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
+  if (output.isDisabled())
     return false;
 
-  return true;
+  // Mono in, stereo out: one channel processed, copied to both outputs
+  if (input == juce::AudioChannelSet::mono() &&
+      output == juce::AudioChannelSet::stereo())
+    return true;
+
+  return output == input;
 }
 
 //==============================================================================
 void VT2BBlackProcessor::processBlock(juce::AudioBuffer<float> &buffer,
                                       juce::MidiBuffer &midiMessages) {
-  juce::ScopedNoDenormals noDenormals;
+  VT2R_TRACE_SCOPE("processBlock");
   juce::ignoreUnused(midiMessages);
+  VT2RDSP::AudioThreadWatchdog::BlockScope watchdogScope(
+      watchdog, buffer.getNumSamples(), currentSampleRate);
+  processSamples(buffer, floatEngine);
+}
+
+void VT2BBlackProcessor::processBlock(juce::AudioBuffer<double> &buffer,
+                                      juce::MidiBuffer &midiMessages) {
+  VT2R_TRACE_SCOPE("processBlock");
+  juce::ignoreUnused(midiMessages);
+  VT2RDSP::AudioThreadWatchdog::BlockScope watchdogScope(
+      watchdog, buffer.getNumSamples(), currentSampleRate);
+  processSamples(buffer, doubleEngine);
+}
+
+juce::String VT2BBlackProcessor::createWatchdogReport() const {
+  using Watchdog = VT2RDSP::AudioThreadWatchdog;
+  const auto snapshot = watchdog.getSnapshot();
+
+  juce::String report;
+  report << "VT-2R audio thread report\n"
+         << "blocks: " << juce::String(juce::int64(snapshot.numBlocks))
+         << ", mean load: " << juce::String(snapshot.meanLoad * 100.0, 1)
+         << " %, worst: " << juce::String(snapshot.worstLoad * 100.0, 1)
+         << " %, overruns (> 100 %): " << juce::String(snapshot.numOverruns)
+         << "\n";
+
+  if (VT2RDSP::RealtimeSafety::kInstrumented)
+    report << "heap operations in callback: "
+           << juce::String(snapshot.heapOperations)
+           << ", blocking calls in callback: "
+           << juce::String(snapshot.blockingCalls) << "\n";
+  else
+    report << "heap/lock detection: not instrumented (VT2R_RT_WATCHDOG=0)\n";
+
+  report << "load histogram (% of realtime budget):\n";
+  for (int i = 0; i < Watchdog::kNumBins; ++i) {
+    const auto count = snapshot.bins[size_t(i)];
+    if (count == 0)
+      continue;
+
+    const int from = juce::roundToInt(i * Watchdog::kBinWidth * 100.0);
+    const int to = juce::roundToInt((i + 1) * Watchdog::kBinWidth * 100.0);
+    const auto range = i == Watchdog::kNumBins - 1
+                           ? ">= " + juce::String(from)
+                           : juce::String(from) + "-" + juce::String(to);
+
+    report << "  " << (range + " %").paddedRight(' ', 12)
+           << juce::String(count) << "\n";
+  }
+
+  return report;
+}
+
+template <typename SampleType>
+void VT2BBlackProcessor::processSamples(juce::AudioBuffer<SampleType> &buffer,
+                                        Engine<SampleType> &engine) {
+  using VT2RDSP::ChannelLayout;
+
+  switch (VT2RDSP::getChannelLayout(getTotalNumInputChannels(),
+                                    getTotalNumOutputChannels())) {
+  case ChannelLayout::Mono:
+    processLayout<ChannelLayout::Mono>(buffer, engine);
+    break;
+  case ChannelLayout::Stereo:
+    processLayout<ChannelLayout::Stereo>(buffer, engine);
+    break;
+  case ChannelLayout::MonoToStereo:
+    processLayout<ChannelLayout::MonoToStereo>(buffer, engine);
+    break;
+  case ChannelLayout::Multichannel:
+  default:
+    processLayout<ChannelLayout::Multichannel>(buffer, engine);
+    break;
+  }
+}
+
+template <VT2RDSP::ChannelLayout Layout, typename SampleType>
+void VT2BBlackProcessor::processLayout(juce::AudioBuffer<SampleType> &buffer,
+                                       Engine<SampleType> &engine) {
+  juce::ScopedNoDenormals noDenormals;
+
+  if (preparedBlockSize == 0 || !engine.isPrepared())
+    return;
+
+  constexpr int kNumChannels = VT2RDSP::getNumProcessedChannels(Layout);
+  constexpr bool kMonoToStereo =
+      Layout == VT2RDSP::ChannelLayout::MonoToStereo;
 
   auto totalNumInputChannels = getTotalNumInputChannels();
   auto totalNumOutputChannels = getTotalNumOutputChannels();
 
-  for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-    buffer.clear(i, 0, buffer.getNumSamples());
+  // Outputs without an input (mono -> stereo: overwritten at the end)
+  if constexpr (!kMonoToStereo)
+    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
+      buffer.clear(i, 0, buffer.getNumSamples());
 
-  float drive = *driveParameter;
-  float mix = *mixParameter / 100.0f;
+  const int numChannels =
+      kNumChannels > 0 ? kNumChannels
+                       : juce::jmin(totalNumInputChannels,
+                                    engine.wetBuffer.getNumChannels());
+  const int numSamples = buffer.getNumSamples();
 
-  smoothedDrive.setTargetValue(drive);
-  smoothedMix.setTargetValue(mix);
+  // --- Input levels: silence detection (and the meters, see below) ---
+  const bool metering = meteringEnabled.load(std::memory_order_relaxed);
+  VT2RDSP::MeterFrame meter;
 
-  auto *channelDataL = buffer.getWritePointer(0);
-  auto *channelDataR =
-      totalNumInputChannels > 1 ? buffer.getWritePointer(1) : nullptr;
+  SampleType inputPeak = 0;
+  for (int ch = 0; ch < numChannels; ++ch)
+    inputPeak = juce::jmax(inputPeak, buffer.getMagnitude(ch, 0, numSamples));
 
-  for (int sample = 0; sample < buffer.getNumSamples(); ++sample) {
-    float currentDrive = smoothedDrive.getNextValue();
-    float currentMix = smoothedMix.getNextValue();
+  if (metering) {
+    meter.inputPeak = float(inputPeak);
+    meter.inputRms = float(getMaxRmsLevel(buffer, numChannels));
+  }
 
-    float dryL = channelDataL[sample];
-    float dryR = channelDataR ? channelDataR[sample] : dryL;
+  // Once the input has been silent for the whole tail (filters decayed,
+  // dry delay flushed) the output is silent too: idle until signal returns.
+  // Waking up needs no fade - every state is already at rest.
+  const bool inputSilent =
+      inputPeak < SampleType(VT2RConstants::kSilenceThreshold);
+
+  if (inputSilent && engine.silentSamples >= engine.idleAfterSamples) {
+    if (engine.wetPathRunning) {
+      suspendWetPath(engine);
+      engine.dryDelayBuffer.clear();
+      engine.dryFilterRunning = false;
+    }
 
-    // --- Signal Chain ---
+    engine.smoothedDrive.setTargetValue(SampleType(driveParameter->load()));
+    engine.smoothedMix.setTargetValue(SampleType(mixParameter->load()) /
+                                      SampleType(100));
+    engine.smoothedDrive.advance(numSamples);
+    engine.smoothedMix.advance(numSamples);
+    engine.subBlockPhase =
+        (engine.subBlockPhase + numSamples) % VT2RConstants::kSubBlockSize;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+      buffer.clear(ch, 0, numSamples);
+  } else {
+    engine.silentSamples =
+        inputSilent ? juce::jmin(engine.silentSamples + numSamples,
+                                 engine.idleAfterSamples)
+                    : 0;
+
+    // Chunks end on the sub-block grid (or at the end of the buffer), so
+    // the sub-blocks fall on the same samples whatever the host's buffer
+    // size. Nothing is held back: a sub-block cut short by the end of this
+    // buffer is finished at the start of the next. Offline renders with
+    // workers take several sub-blocks per chunk (same output).
+    const int chunkLength = isNonRealtime() && offlineWorkers != nullptr
+                                ? engine.maxChunkSamples
+                                : VT2RConstants::kSubBlockSize;
+
+    for (int start = 0; start < numSamples;) {
+      const int chunkSize = juce::jmin(chunkLength - engine.subBlockPhase,
+                                       numSamples - start);
+
+      for (int ch = 0; ch < numChannels; ++ch)
+        engine.chunkChannels[size_t(ch)] = buffer.getWritePointer(ch, start);
+
+      processChunk<Layout>(engine, engine.chunkChannels.data(), numChannels,
+                           chunkSize);
+      start += chunkSize;
+    }
+  }
 
-    // 1. Input Gain & Pre-Emphasis
-    // Boost mids to make them hit saturation harder ("Forward" character)
-    float wetL = processPreEmphasis(dryL, currentDrive, midBoostStateL);
+  // Peak saturator input of this block (cleared even while not metering)
+  const SampleType drivenPeak = takeDrivenPeak(engine.laneFilterStates);
 
-    // 2. Saturation (Steep Sigmoid / Solid State)
-    wetL = processSaturation(wetL, currentDrive);
+  // --- Meters (only while the editor is open) ---
+  if (metering) {
+    SampleType outputPeak = 0;
+    for (int ch = 0; ch < numChannels; ++ch)
+      outputPeak =
+          juce::jmax(outputPeak, buffer.getMagnitude(ch, 0, numSamples));
 
-    // 3. Output makeup
-    wetL *= calculateMakeupGain(currentDrive);
+    meter.outputPeak = float(outputPeak);
+    meter.outputRms = float(getMaxRmsLevel(buffer, numChannels));
 
-    // Right Channel
-    float wetR = dryR;
-    if (channelDataR != nullptr) {
-      wetR = processPreEmphasis(dryR, currentDrive, midBoostStateR);
-      wetR = processSaturation(wetR, currentDrive);
-      wetR *= calculateMakeupGain(currentDrive);
-    } else {
-      wetR = wetL;
+    // Saturator compression at the peak of its actual input, as the lane
+    // kernels saw it (0 while the wet path is off)
+    const auto driven = double(drivenPeak);
+    if (driven > 1.0e-9)
+      meter.saturation = float(1.0 - std::tanh(driven) / driven);
+
+    meterFifo.push(meter); // dropped if the UI has fallen behind
+  }
+
+  if constexpr (kMonoToStereo)
+    buffer.copyFrom(1, 0, buffer, 0, 0, numSamples);
+}
+
+template <typename SampleType>
+void VT2BBlackProcessor::suspendWetPath(Engine<SampleType> &engine) {
+  for (int g = 0; g < engine.oversampler.getNumGroups(); ++g)
+    resetLaneGroup(engine, g);
+  engine.wetPathRunning = false;
+}
+
+template <typename SampleType>
+void VT2BBlackProcessor::resetLaneGroup(Engine<SampleType> &engine, int g) {
+  const auto group = size_t(g);
+  engine.oversampler.resetGroup(g);
+  engine.laneFilterStates[group] = {};
+  if (group < engine.adaa1States.size())
+    engine.adaa1States[group] = {};
+  engine.glueStates[group] = {};
+}
+
+template <VT2RDSP::ChannelLayout Layout, typename SampleType>
+void VT2BBlackProcessor::processChunk(Engine<SampleType> &engine,
+                                      SampleType *const *io, int numChannels,
+                                      int numSamples) {
+  // Mono / stereo: a constant channel count unrolls the loops below
+  constexpr int kNumChannels = VT2RDSP::getNumProcessedChannels(Layout);
+  if constexpr (kNumChannels > 0)
+    numChannels = kNumChannels;
+
+  constexpr int kSubBlockSize = VT2RConstants::kSubBlockSize;
+  const auto quality = static_cast<VT2RDSP::SaturationQuality>(
+      juce::roundToInt(qualityParameter->load()));
+
+  // --- Control Rate (once per sub-block, for the whole chunk first) ---
+  int numSubBlocks = 0;
+  int numSlices = 0;
+  bool wetPathNeeded = false; // some sub-block runs or stops the wet path
+
+  for (int start = 0; start < numSamples; ++numSubBlocks) {
+    const int size =
+        juce::jmin(kSubBlockSize - engine.subBlockPhase, numSamples - start);
+    auto &control = engine.subBlocks[size_t(numSubBlocks)];
+
+    updateSubBlockControl(engine, control, start, size, numSlices);
+    wetPathNeeded = wetPathNeeded || control.wet || control.stopWet;
+
+    start += size;
+    engine.subBlockPhase = (engine.subBlockPhase + size) % kSubBlockSize;
+  }
+
+  if (wetPathNeeded)
+    processWetPath(engine, io, numChannels, numSubBlocks, numSamples,
+                   quality);
+
+  // 4. Mix (dry delayed by the oversampling latency)
+  const SampleType *const *wet = engine.wetBuffer.getArrayOfReadPointers();
+  const int latency = engine.dryDelaySamples;
+
+  for (int s = 0; s < numSubBlocks; ++s) {
+    const auto &control = engine.subBlocks[size_t(s)];
+    const int offset = control.start;
+    const int size = control.numSamples;
+    const SampleType mix = control.mix;
+    const SampleType dryGain = SampleType(1) - mix;
+    const SampleType *mixGains = engine.mixGains.data() + offset;
+    int position = engine.dryDelayPosition;
+
+    // Minimum phase: dry through the wet path's filters, in place
+    if (engine.filterDryPath) {
+      const bool dryUnused =
+          control.wet && control.mixSettled && mix == SampleType(1);
+
+      if (dryUnused) {
+        engine.dryFilterRunning = false;
+      } else {
+        if (!engine.dryFilterRunning)
+          engine.dryOversampler.reset();
+        engine.dryFilterRunning = true;
+
+        for (int ch = 0; ch < numChannels; ++ch) {
+          engine.groupInputs[size_t(ch)] = io[ch] + offset;
+          engine.groupOutputs[size_t(ch)] = io[ch] + offset;
+        }
+        engine.dryOversampler.processUp(engine.groupInputs.data(),
+                                        numChannels, size);
+        engine.dryOversampler.processDown(engine.groupOutputs.data(),
+                                          numChannels, size);
+      }
+    }
+
+    for (int ch = 0; ch < numChannels; ++ch) {
+      SampleType *out = io[ch] + offset;
+      const SampleType *wetIn = wet[ch] + offset;
+
+      // Delay line first, so the blend below is a plain vector loop
+      if (latency > 0) {
+        auto *delay = engine.dryDelayBuffer.getWritePointer(ch);
+        position = engine.dryDelayPosition;
+
+        for (int i = 0; i < size; ++i) {
+          std::swap(out[i], delay[position]);
+          if (++position == latency)
+            position = 0;
+        }
+      }
+
+      if (!control.wet)
+        continue; // Mix 0: delayed dry only
+
+      if (control.mixSettled) {
+        for (int i = 0; i < size; ++i)
+          out[i] = out[i] * dryGain + wetIn[i] * mix;
+      } else {
+        for (int i = 0; i < size; ++i)
+          out[i] = out[i] * (SampleType(1) - mixGains[i]) +
+                   wetIn[i] * mixGains[i];
+      }
     }
 
-    // Mix
-    channelDataL[sample] = dryL * (1.0f - currentMix) + wetL * currentMix;
-    if (channelDataR != nullptr)
-      channelDataR[sample] = dryR * (1.0f - currentMix) + wetR * currentMix;
+    engine.dryDelayPosition = position;
   }
 }
 
-//==============================================================================
-// DSP Implementations
+template <typename SampleType>
+void VT2BBlackProcessor::updateSubBlockControl(
+    Engine<SampleType> &engine, SubBlockControl<SampleType> &control,
+    int start, int numSamples, int &numSlices) {
+  constexpr int kSliceSize = VT2RConstants::kCoefficientUpdateInterval;
+
+  engine.smoothedDrive.setTargetValue(SampleType(driveParameter->load()));
+  engine.smoothedMix.setTargetValue(SampleType(mixParameter->load()) /
+                                    SampleType(100));
+
+  control.start = start;
+  control.numSamples = numSamples;
+
+  // Mix settled at 0 discards the wet path, so it is not computed at all.
+  // It restarts from cleared state when Mix moves again; the Mix ramp
+  // (starting at 0) fades it in.
+  control.wet = engine.smoothedMix.isSmoothing() ||
+                engine.smoothedMix.getTargetValue() != SampleType(0);
+  control.stopWet = !control.wet && engine.wetPathRunning;
+  control.startPreEmphasis = false;
+  engine.wetPathRunning = control.wet;
+
+  if (!control.wet) {
+    engine.smoothedDrive.advance(numSamples);
+  } else {
+    control.driveSettled = !engine.smoothedDrive.isSmoothing();
+    control.drive = engine.smoothedDrive.getTargetValue();
+    control.saturatorOnly =
+        control.driveSettled && control.drive == SampleType(0);
+
+    if (control.saturatorOnly) {
+      // Drive 0: flat pre-emphasis and unity gains leave the saturator only
+      // (and the zero-amount glue stages, see saturateLanes).
+      // The biquad restarts from rest afterwards; its state mismatch is
+      // scaled by the (still near-flat) boost and decays within its ~1 ms
+      // tail.
+      engine.preEmphasisRunning = false;
+    } else {
+      control.startPreEmphasis = !engine.preEmphasisRunning;
+      engine.preEmphasisRunning = true;
+
+      if (control.driveSettled) {
+        // Settled Drive: gains and coefficients are constant
+        updatePreEmphasisCoefficients(engine, control.drive);
+        control.coeffs = engine.preEmphasisCoeffs;
+        control.inputGain = calculateSaturationGain(control.drive);
+        control.makeupGain = calculateMakeupGain(control.drive);
+        control.normDrive = control.drive / SampleType(100);
+      } else {
+        // Drive ramp: per-sample gains, coefficients once per control
+        // slice. Slices sit on the sub-block grid; a sub-block that starts
+        // inside one (at a host buffer boundary) keeps its coefficients.
+        control.firstSlice = numSlices;
+        control.slicePhase = engine.subBlockPhase % kSliceSize;
+        int slicePhase = control.slicePhase;
+
+        for (int i = 0; i < numSamples; slicePhase = 0) {
+          const int sliceSize =
+              juce::jmin(kSliceSize - slicePhase, numSamples - i);
+
+          SampleType drive[kSliceSize];
+          engine.smoothedDrive.fill(drive, sliceSize);
+          if (slicePhase == 0 || (i == 0 && control.startPreEmphasis))
+            updatePreEmphasisCoefficients(engine, drive[0]);
+          engine.rampCoeffs[size_t(numSlices++)] = engine.preEmphasisCoeffs;
+
+          for (int j = 0; j < sliceSize; ++j, ++i) {
+            const auto index = size_t(start + i);
+            engine.rampInputGain[index] = calculateSaturationGain(drive[j]);
+            engine.rampMakeupGain[index] = calculateMakeupGain(drive[j]);
+            engine.rampNormDrive[index] = drive[j] / SampleType(100);
+          }
+        }
+      }
+    }
+  }
 
-float VT2BBlackProcessor::processPreEmphasis(float input, float drive,
-                                             FilterState &state) {
-  // Drive 0-100 -> Gain 0dB to +9dB
-  float normDrive = drive / 100.0f;
-  float gainDb = normDrive * VT2RConstants::kMaxPreEmphasisGainDb;
-
-  // Calculate Coefficients for Peaking EQ
-  // Simplified RBJ Biquad for fixed freq/Q but variable gain
-  // In a real loop, optimization would compute coeffs only when drive changes
-  // But per-sample update with smoothing is safer for artifacts, though
-  // expensive. For simplicity here, we recompute (or ideally use a smoothed
-  // variable). To save CPU, we'll assume coefficients don't change drastically
-  // per sample or accept the cost. Optimization: Coeffs only depend on 'gainDb'
-  // which depends on 'drive'.
-
-  double A = std::pow(10.0, gainDb / 40.0);
-  double w0 = 2.0 * juce::MathConstants<double>::pi *
-              VT2RConstants::kPreEmphasisFreq / currentSampleRate;
-  double alpha = std::sin(w0) / (2.0 * VT2RConstants::kPreEmphasisQ);
-
-  double b0 = 1.0 + alpha * A;
-  double b1 = -2.0 * std::cos(w0);
-  double b2 = 1.0 - alpha * A;
-  double a0 = 1.0 + alpha / A;
-  double a1 = -2.0 * std::cos(w0);
-  double a2 = 1.0 - alpha / A;
-
-  // Normalize by a0
-  float fb0 = float(b0 / a0);
-  float fb1 = float(b1 / a0);
-  float fb2 = float(b2 / a0);
-  float fa1 = float(a1 / a0);
-  float fa2 = float(a2 / a0);
-
-  // Biquad Process
-  float output = fb0 * input + fb1 * state.z1 + fb2 * state.z2 -
-                 fa1 * state.z1 - fa2 * state.z2;
-
-  // Update state (using DF1)
-  // Actually standard DF1: y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] - a1*y[n-1] -
-  // a2*y[n-2] My state struct needs to store inputs and outputs or use DF2.
-  // Let's us DF2 Transposed or DF1.
-  // DF1 requires storing x[n-1], x[n-2], y[n-1], y[n-2].
-  // Let's switch to DF2 for 2 state vars.
-  // DF2:
-  // w[n] = x[n] - a1*w[n-1] - a2*w[n-2]
-  // y[n] = b0*w[n] + b1*w[n-1] + b2*w[n-2]
-
-  // Let's use simpler state update for DF1 if I change struct, but I have z1,
-  // z2. Let's assume z1, z2 are x_n1, x_n2? No usually y too for IIR. Let's
-  // restart logic with a proper DF2.
-
-  float w = input - fa1 * state.z1 - fa2 * state.z2;
-  output = fb0 * w + fb1 * state.z1 + fb2 * state.z2;
-
-  // Denormal protection
-  if (std::abs(w) < 1e-20f)
-    w = 0.0f;
-
-  state.z2 = state.z1;
-  state.z1 = w;
-
-  return output;
+  control.mixSettled = !engine.smoothedMix.isSmoothing();
+  control.mix = engine.smoothedMix.getTargetValue();
+  if (!control.mixSettled)
+    engine.smoothedMix.fill(engine.mixGains.data() + start, numSamples);
 }
 
-float VT2BBlackProcessor::processSaturation(float input, float drive) {
-  // Solid State / Transformer Hybird
-  // Steep sigmoid: tanh(k * x)
+template <typename SampleType>
+void VT2BBlackProcessor::processWetPath(Engine<SampleType> &engine,
+                                        const SampleType *const *input,
+                                        int numChannels, int numSubBlocks,
+                                        int numSamples,
+                                        VT2RDSP::SaturationQuality quality) {
+  auto &oversampler = engine.oversampler;
+  const int factor = oversampler.getFactor();
+  const int numGroups = VT2RDSP::getNumLaneGroups<SampleType>(numChannels);
+  constexpr int kNumLanes = VT2RDSP::SIMDRegister<SampleType>::kNumLanes;
+  constexpr int kSliceSize = VT2RConstants::kCoefficientUpdateInterval;
+
+  // process(stages, saturatorFor): stages is the character's GlueStages
+  // (an empty tag, passed on as the kernels' template argument) and
+  // saturatorFor(g) the saturator for lane group g - a stateless tanh of the
+  // quality tier, or ADAA on the group's history
+  auto runKernel = [&](auto &&process) {
+    auto withSaturator = [&](auto stages) {
+      switch (engine.antialiasing) {
+      case VT2RDSP::Antialiasing::FirstOrder:
+        process(stages, [&](int g) {
+          return VT2RDSP::TanhADAA1<SampleType>{
+              engine.adaa1States[size_t(g)]};
+        });
+        return;
+      case VT2RDSP::Antialiasing::Off:
+      default:
+        break;
+      }
+
+      switch (quality) {
+      case VT2RDSP::SaturationQuality::Eco:
+        process(stages, [](int) { return VT2RDSP::TanhRational(); });
+        break;
+      case VT2RDSP::SaturationQuality::Normal:
+        process(stages, [](int) { return VT2RDSP::TanhTable(); });
+        break;
+      case VT2RDSP::SaturationQuality::Precise:
+      default:
+        process(stages, [](int) { return VT2RDSP::TanhPolynomial(); });
+        break;
+      }
+    };
+
+    if (engine.character == VT2RDSP::Character::Glue)
+      withSaturator(VT2RDSP::GlueCharacterStages());
+    else
+      withSaturator(VT2RDSP::AggressiveStages());
+  };
+
+  // --- Signal Chain (per lane group: up, one fused kernel pass, down) ---
+  // 1. Pre-Emphasis  2. Saturation (+ glue stages)  3. Output makeup
+  SampleType *const *output = engine.wetBuffer.getArrayOfWritePointers();
+
+  // Mono, Aggressive, no ADAA: nothing but the biquad has state, so a
+  // settled Drive runs consecutive samples side by side in the lanes
+  // (block biquad, see processMonoLanesConstant)
+  const bool monoTimeLanes =
+      numChannels == 1 &&
+      engine.character == VT2RDSP::Character::Aggressive &&
+      engine.antialiasing == VT2RDSP::Antialiasing::Off;
+
+  runKernel([&](auto stages, const auto &saturatorFor) {
+    using Stages = decltype(stages);
+
+    auto processGroup = [&](int g) {
+      const int firstChannel = g * kNumLanes;
+      const int endChannel = juce::jmin(numChannels, firstChannel + kNumLanes);
+      auto &filterState = engine.laneFilterStates[size_t(g)];
+      auto &glueState = engine.glueStates[size_t(g)];
+
+      for (int s = 0; s < numSubBlocks; ++s) {
+        const auto &sub = engine.subBlocks[size_t(s)];
+        const int n = sub.numSamples;
+
+        if (sub.stopWet)
+          resetLaneGroup(engine, g);
+        if (!sub.wet)
+          continue;
+        if (sub.startPreEmphasis)
+          filterState = {};
+
+        // Wet path input: channels interleaved as lanes (and oversampled)
+        for (int ch = firstChannel; ch < endChannel; ++ch) {
+          engine.groupInputs[size_t(ch)] = input[ch] + sub.start;
+          engine.groupOutputs[size_t(ch)] = output[ch] + sub.start;
+        }
+
+        oversampler.processUpGroup(g, engine.groupInputs.data(), numChannels,
+                                   n);
+        auto *lanes = oversampler.getLanes(g);
+
+        if (sub.saturatorOnly) {
+          VT2RDSP::saturateLanes<Stages>(lanes, n * factor, engine.glueCoeffs,
+                                         filterState, glueState,
+                                         saturatorFor(g));
+        } else if (sub.driveSettled && monoTimeLanes) {
+          VT2RDSP::processMonoLanesConstant(
+              lanes, n * factor, sub.coeffs,
+              engine.preEmphasisTable->lookupBlock(sub.drive),
+              engine.glueCoeffs, sub.inputGain, sub.makeupGain,
+              sub.normDrive, filterState, glueState, saturatorFor(g));
+        } else if (sub.driveSettled) {
+          VT2RDSP::processWetLanesConstant<Stages>(
+              lanes, n * factor, sub.coeffs, engine.glueCoeffs,
+              sub.inputGain, sub.makeupGain, sub.normDrive, filterState,
+              glueState, saturatorFor(g));
+        } else {
+          int slice = sub.firstSlice;
+          for (int i = 0, slicePhase = sub.slicePhase; i < n;
+               slicePhase = 0) {
+            const int sliceSize = juce::jmin(kSliceSize - slicePhase, n - i);
+            const int offset = sub.start + i;
+            const VT2RDSP::ControlSlice<SampleType> control{
+                engine.rampInputGain.data() + offset,
+                engine.rampMakeupGain.data() + offset,
+                engine.rampNormDrive.data() + offset};
+
+            VT2RDSP::processWetLanes<Stages>(
+                lanes + i * factor, sliceSize, factor,
+                engine.rampCoeffs[size_t(slice++)], engine.glueCoeffs,
+                control, filterState, glueState, saturatorFor(g));
+            i += sliceSize;
+          }
+        }
+
+        // Back to the base rate (planar)
+        oversampler.processDownGroup(g, engine.groupOutputs.data(),
+                                     numChannels, n);
+      }
+    };
+
+    // Offline renders spread the groups over the workers (checked per
+    // block: hosts switch render mode without preparing again)
+    if (offlineWorkers != nullptr && isNonRealtime() &&
+        numSamples >= VT2RConstants::kMinParallelChunkSize)
+      offlineWorkers->run(numGroups, processGroup);
+    else
+      for (int g = 0; g < numGroups; ++g)
+        processGroup(g);
+  });
+}
 
-  float normDrive = drive / 100.0f;
+//==============================================================================
+// DSP Implementations
 
-  // Input Gain boost: Up to +18dB driving the saturator
-  float inputGain = 1.0f + normDrive * 8.0f;
+template <typename SampleType>
+void VT2BBlackProcessor::updatePreEmphasisCoefficients(
+    Engine<SampleType> &engine, SampleType drive) {
+  if (drive == engine.preEmphasisDrive)
+    return;
 
-  float x = input * inputGain;
+  engine.preEmphasisCoeffs = engine.preEmphasisTable->lookup(drive);
+  engine.preEmphasisDrive = drive;
+}
 
-  // Saturator
-  // Tanh is clean odd harmonics.
-  // To make it "aggressive/biting", we can use a harder clipper or scale tanh.
-  // Or mix in some x^3.
+template <typename SampleType>
+SampleType VT2BBlackProcessor::calculateSaturationGain(SampleType drive) {
+  SampleType normDrive = drive / SampleType(100);
 
-  // Simple tanh for now, it's punchy if driven hard.
-  return std::tanh(x);
+  // Input Gain boost: Up to +18dB driving the saturator
+  return SampleType(1) + normDrive * SampleType(8);
 }
 
-float VT2BBlackProcessor::calculateMakeupGain(float drive) {
-  float normDrive = drive / 100.0f;
+template <typename SampleType>
+SampleType VT2BBlackProcessor::calculateMakeupGain(SampleType drive) {
+  SampleType normDrive = drive / SampleType(100);
   // Tanh limits to 1.0. If we boost input by 8x, we need to bring it down,
   // but not fully, to keep perceived loudness.
   // Auto-gain roughly compensates for the inputGain boost.
   // inputGain was 1 + drive*8.
-  return 1.0f / (1.0f + normDrive * 4.0f); // Compensate partially
+  return SampleType(1) /
+         (SampleType(1) + normDrive * SampleType(4)); // Compensate partially
 }
 
 //==============================================================================
@@ -284,20 +939,50 @@ juce::AudioProcessorEditor *VT2BBlackProcessor::createEditor() {
 }
 
 //==============================================================================
+// Binary format: see PluginState.h. XML blobs from earlier versions still
+// load; they are recognised by the missing VT2R header.
 void VT2BBlackProcessor::getStateInformation(juce::MemoryBlock &destData) {
-  auto state = parameters.copyState();
-  std::unique_ptr<juce::XmlElement> xml(state.createXml());
-  copyXmlToBinary(*xml, destData);
+  VT2R_TRACE_SCOPE("getStateInformation");
+  VT2RState::Fields fields;
+  for (int i = 0; i < VT2RState::kNumFields; ++i)
+    fields[size_t(i)] = stateValues[size_t(i)]->load();
+
+  destData.setSize(size_t(VT2RState::kSize));
+  VT2RState::write(fields, destData.getData());
 }
 
 void VT2BBlackProcessor::setStateInformation(const void *data,
                                              int sizeInBytes) {
+  VT2R_TRACE_SCOPE("setStateInformation");
+
+  if (VT2RState::isBinary(data, sizeInBytes)) {
+    VT2RState::Fields fields{};
+    const int numFields = VT2RState::read(data, sizeInBytes, fields);
+
+    for (int i = 0; i < numFields; ++i) {
+      auto *parameter = stateParameters[size_t(i)];
+      parameter->setValueNotifyingHost(
+          parameter->convertTo0to1(fields[size_t(i)]));
+    }
+    return;
+  }
+
   std::unique_ptr<juce::XmlElement> xmlState(
       getXmlFromBinary(data, sizeInBytes));
 
   if (xmlState.get() != nullptr)
-    if (xmlState->hasTagName(parameters.state.getType()))
-      parameters.replaceState(juce::ValueTree::fromXml(*xmlState));
+    if (xmlState->hasTagName(parameters.state.getType())) {
+      auto state = juce::ValueTree::fromXml(*xmlState);
+
+      // Sessions from before oversampling existed keep running without it
+      // (and without its latency), rather than taking the new default
+      if (!state.getChildWithProperty("id", "oversampling").isValid())
+        state.appendChild(juce::ValueTree("PARAM", {{"id", "oversampling"},
+                                                    {"value", 0}}),
+                          nullptr);
+
+      parameters.replaceState(state);
+    }
 }
 
 //==============================================================================
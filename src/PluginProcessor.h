@@ -12,6 +12,18 @@
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_audio_utils/juce_audio_utils.h>
 
+#include "AntiderivativeSaturation.h"
+#include "AudioThreadWatchdog.h"
+#include "ChannelLayout.h"
+#include "GlueChain.h"
+#include "LaneKernel.h"
+#include "MeterFifo.h"
+#include "Oversampler.h"
+#include "ParameterSmoother.h"
+#include "PluginState.h"
+#include "PreEmphasisTable.h"
+#include "WorkerPool.h"
+
 //==============================================================================
 /**
  * VT-2B Black Processor
@@ -19,7 +31,10 @@
  * コンソールサミング/バス回路を意識した密度増加型サチュレーション。
  * 派手さを抑え、音をまとめる方向に作用する。
  */
-class VT2BBlackProcessor : public juce::AudioProcessor {
+class VT2BBlackProcessor
+    : public juce::AudioProcessor,
+      private juce::AudioProcessorValueTreeState::Listener,
+      private juce::AsyncUpdater {
 public:
   //==============================================================================
   VT2BBlackProcessor();
@@ -32,6 +47,10 @@ public:
   bool isBusesLayoutSupported(const BusesLayout &layouts) const override;
 
   void processBlock(juce::AudioBuffer<float> &, juce::MidiBuffer &) override;
+  void processBlock(juce::AudioBuffer<double> &, juce::MidiBuffer &) override;
+
+  // 64-bit hosts get a native double path (no per-block conversion)
+  bool supportsDoublePrecisionProcessing() const override { return true; }
 
   //==============================================================================
   juce::AudioProcessorEditor *createEditor() override;
@@ -60,6 +79,29 @@ public:
   // パラメータアクセス
   juce::AudioProcessorValueTreeState &getParameters() { return parameters; }
 
+  //==============================================================================
+  // メーター (audio thread -> UI)
+
+  /**
+   * Turned on by the editor while it is open. Off, processBlock measures
+   * nothing and pushes nothing.
+   */
+  void setMeteringEnabled(bool shouldMeter) {
+    meteringEnabled.store(shouldMeter, std::memory_order_relaxed);
+  }
+
+  /** UI thread only: the next block's levels, false when none pending. */
+  bool popMeterFrame(VT2RDSP::MeterFrame &frame) {
+    return meterFifo.pop(frame);
+  }
+
+  //==============================================================================
+  // Audio thread watchdog (block load histogram, RT-safety counters)
+  const VT2RDSP::AudioThreadWatchdog &getWatchdog() const { return watchdog; }
+
+  /** Text dump of the histogram and counters since the last prepare. */
+  juce::String createWatchdogReport() const;
+
 private:
   //==============================================================================
   // パラメータ
@@ -67,45 +109,257 @@ private:
 
   std::atomic<float> *driveParameter = nullptr;
   std::atomic<float> *mixParameter = nullptr;
+  std::atomic<float> *qualityParameter = nullptr;
+  std::atomic<float> *oversamplingParameter = nullptr;
+  std::atomic<float> *oversamplingFilterParameter = nullptr;
+  std::atomic<float> *antialiasingParameter = nullptr;
+  std::atomic<float> *characterParameter = nullptr;
+
+  // Binary state fields (VT2RState::kParameterIds order)
+  std::array<juce::RangedAudioParameter *, VT2RState::kNumFields>
+      stateParameters{};
+  std::array<std::atomic<float> *, VT2RState::kNumFields> stateValues{};
+
+  void parameterChanged(const juce::String &parameterID,
+                        float newValue) override;
+  void handleAsyncUpdate() override;
 
   //==============================================================================
   // DSP状態
   double currentSampleRate = 44100.0;
+  int preparedBlockSize = 0;
+  double tailLengthSeconds = 0.0;
+
+  /**
+   * Control-rate decisions and values for one sub-block of a chunk, worked
+   * out before the lane groups run (see updateSubBlockControl).
+   */
+  template <typename SampleType> struct SubBlockControl {
+    int start = 0; // in the chunk
+    int numSamples = 0;
+
+    // Wet path: runs (Mix not settled at 0), stops before this sub-block
+    // (clear the lane group histories), biquad restarts from rest
+    bool wet = false;
+    bool stopWet = false;
+    bool startPreEmphasis = false;
+
+    // Drive: settled (constant gains and coefficients below) or ramping
+    // (per-sample values in the engine's ramp arrays, coefficients from
+    // rampCoeffs[firstSlice] on, the first slice slicePhase samples in)
+    bool driveSettled = true;
+    bool saturatorOnly = false; // settled at 0
+    SampleType drive = 0;
+    SampleType inputGain = 1, makeupGain = 1, normDrive = 0;
+    VT2RDSP::BiquadCoefficients<SampleType> coeffs;
+    int firstSlice = 0;
+    int slicePhase = 0;
+
+    // Mix: settled at mix, or ramping (mixGains)
+    bool mixSettled = true;
+    SampleType mix = 0;
+  };
+
+  /**
+   * Processing state in one precision (float or double). Only the engine
+   * for the precision the host processes in is prepared; the other one
+   * stays empty.
+   */
+  template <typename SampleType> struct Engine {
+    // Oversampling (wet path, channels as SIMD lanes) + aligned dry path
+    VT2RDSP::Oversampler<SampleType> oversampler;
+    juce::AudioBuffer<SampleType> wetBuffer; // wet path back at the base rate
+    juce::AudioBuffer<SampleType> dryDelayBuffer;
+    int dryDelayPosition = 0;
+    int dryDelaySamples = 0; // oversampling latency + whole ADAA samples
+
+    // Minimum phase: the dry path runs through the same up/down filters
+    // (dryOversampler, no saturator in between) instead of the delay line,
+    // which only keeps the whole ADAA samples then. Skipped while Mix is
+    // settled at 100; restarts from rest.
+    VT2RDSP::Oversampler<SampleType> dryOversampler;
+    bool filterDryPath = false;
+    bool dryFilterRunning = false;
+    std::vector<SampleType> mixGains; // Mix ramp per sample of a chunk
+    std::vector<SampleType *> chunkChannels; // per-chunk channel pointers
+
+    // Sub-block scheduler: chunks are whole sub-blocks on the fixed grid
+    // (one, or up to maxChunkSamples offline), subBlockPhase samples into
+    // the current one
+    int maxChunkSamples = VT2RConstants::kSubBlockSize;
+    int subBlockPhase = 0;
+    std::vector<SubBlockControl<SampleType>> subBlocks; // of the chunk
+
+    // Channel pointers at the current sub-block; each lane group writes
+    // only its own channels' entries
+    std::vector<const SampleType *> groupInputs;
+    std::vector<SampleType *> groupOutputs;
+
+    // Drive ramp control for a whole chunk, expanded before the lane groups
+    // run (per sample, and coefficients per control slice)
+    std::vector<SampleType> rampInputGain, rampMakeupGain, rampNormDrive;
+    std::vector<VT2RDSP::BiquadCoefficients<SampleType>> rampCoeffs;
+
+    // One state per lane group (kNumLanes channels each), sized in prepare
+    std::vector<VT2RDSP::LaneFilterState<SampleType>> laneFilterStates;
+
+    // Saturator anti-aliasing, taken with the oversampling settings (it
+    // switches the saturator's history); ADAA history per lane group
+    VT2RDSP::Antialiasing antialiasing = VT2RDSP::Antialiasing::Off;
+    std::vector<VT2RDSP::ADAA1State<SampleType>> adaa1States;
+
+    // Glue stages (taken with the oversampling settings too: they set the
+    // tail); coefficients at the processing rate, state per lane group
+    VT2RDSP::Character character = VT2RDSP::Character::Aggressive;
+    VT2RDSP::GlueCoefficients<SampleType> glueCoeffs;
+    std::vector<VT2RDSP::GlueLaneState<SampleType>> glueStates;
+
+    // Skipped work (see processChunk / processSamples)
+    bool wetPathRunning = true;     // false while Mix 0 or idle skip it
+    bool preEmphasisRunning = true; // false while Drive 0 skips the biquad
+    int silentSamples = 0;          // consecutive silent input samples
+    int idleAfterSamples = 0;       // tail length: silence before idling
 
-  // Mid Boost Filter States (Biquad Direct Form I)
-  struct FilterState {
-      float z1 = 0.0f;
-      float z2 = 0.0f;
+    // Pre-Emphasis coefficients (control rate); the table is shared by all
+    // instances at the same processing rate (SharedTableRegistry)
+    std::shared_ptr<const VT2RDSP::PreEmphasisTable<SampleType>>
+        preEmphasisTable;
+    VT2RDSP::BiquadCoefficients<SampleType> preEmphasisCoeffs;
+    SampleType preEmphasisDrive = -1; // Drive the coefficients were taken at
+
+    // スムージング (settled -> block-constant fast path, see processChunk)
+    VT2RDSP::RampSmoother<SampleType> smoothedDrive;
+    VT2RDSP::RampSmoother<SampleType> smoothedMix;
+
+    bool isPrepared() const { return preEmphasisTable != nullptr; }
   };
-  FilterState midBoostStateL, midBoostStateR;
-  
-  // Previous input for basic high-pass/low-pass if needed
-  float lastInL = 0.0f;
-  float lastInR = 0.0f;
 
-  // スムージング
-  juce::SmoothedValue<float> smoothedDrive;
-  juce::SmoothedValue<float> smoothedMix;
+  Engine<float> floatEngine;
+  Engine<double> doubleEngine;
+
+  // Lane groups of the wet path on worker threads while the host renders
+  // offline (isNonRealtime); the process-wide pool when there are at least
+  // two groups, null otherwise
+  std::shared_ptr<VT2RDSP::WorkerPool> offlineWorkers;
+
+  // Metering (one MeterFrame per processBlock while enabled)
+  std::atomic<bool> meteringEnabled{false};
+  VT2RDSP::MeterFifo meterFifo;
+
+  // Times every processBlock (reset in prepareToPlay)
+  VT2RDSP::AudioThreadWatchdog watchdog;
 
   //==============================================================================
   // DSP処理関数
 
   /**
-   * VT-2R Saturation Model
-   * Transformer + Solid State (Steep Sigmoid)
+   * Takes or drops the shared offlineWorkers for the lane groups of the
+   * engine about to be used, in either render mode (processBlock checks
+   * isNonRealtime per block).
+   */
+  void prepareOfflineWorkers(int numGroups);
+
+  /** Smoothers + prepareOversampling for the engine about to be used. */
+  template <typename SampleType> void prepareEngine(Engine<SampleType> &engine);
+
+  /**
+   * (Re)builds the oversampler, the pre-emphasis table and glue
+   * coefficients for the oversampled rate, the ADAA history and the dry
+   * delay, then reports latency/tail.
+   * Allocates - call from prepareToPlay or with processing suspended.
+   */
+  template <typename SampleType>
+  void prepareOversampling(Engine<SampleType> &engine);
+
+  /**
+   * Stops the wet path: clears oversampler, filter, glue and ADAA histories
+   * so that a later restart begins from silence rather than stale audio.
+   */
+  template <typename SampleType>
+  void suspendWetPath(Engine<SampleType> &engine);
+
+  /** suspendWetPath's clearing for lane group g alone. */
+  template <typename SampleType>
+  void resetLaneGroup(Engine<SampleType> &engine, int g);
+
+  /**
+   * Both processBlock overloads: the same code in either precision.
+   * Resolves the bus layout once per block and runs processLayout for it.
+   */
+  template <typename SampleType>
+  void processSamples(juce::AudioBuffer<SampleType> &buffer,
+                      Engine<SampleType> &engine);
+
+  /**
+   * One block in a given layout (see ChannelLayout.h). Input below
+   * VT2RConstants::kSilenceThreshold for longer than the tail idles the
+   * engine (output silence, no DSP) until signal returns.
+   */
+  template <VT2RDSP::ChannelLayout Layout, typename SampleType>
+  void processLayout(juce::AudioBuffer<SampleType> &buffer,
+                     Engine<SampleType> &engine);
+
+  /**
+   * One chunk, in place: whole sub-blocks from the engine's subBlockPhase
+   * (the first one may finish a sub-block begun in the previous buffer,
+   * the last one may stop at the end of this buffer). Control for every
+   * sub-block first, then the wet path (skipped at a settled Mix of 0),
+   * dry delay and the Mix blend. numChannels is ignored for the
+   * fixed-count layouts.
+   */
+  template <VT2RDSP::ChannelLayout Layout, typename SampleType>
+  void processChunk(Engine<SampleType> &engine, SampleType *const *io,
+                    int numChannels, int numSamples);
+
+  /**
+   * Control rate for one sub-block: reads the parameters, advances the
+   * Drive/Mix smoothers and fills in control (ramps into the engine's ramp
+   * arrays from start, coefficients from rampCoeffs[numSlices] on).
+   */
+  template <typename SampleType>
+  void updateSubBlockControl(Engine<SampleType> &engine,
+                             SubBlockControl<SampleType> &control, int start,
+                             int numSamples, int &numSlices);
+
+  /**
+   * Oversampled Pre-Emphasis -> Saturation -> Makeup into wetBuffer for the
+   * chunk's sub-blocks, with the glue stages of the engine's character
+   * fused in (one kernel pass). A settled Drive runs with hoisted
+   * gains/coefficients (Drive 0: the saturator alone); ramps run slice by
+   * slice. The saturator is the quality tier's tanh, or ADAA when
+   * anti-aliasing is on. Mono at a settled Drive (Aggressive, no ADAA)
+   * puts consecutive samples in the lanes instead of channels.
+   *
+   * Lane groups share no state, so each runs up -> kernel -> down through
+   * every sub-block on its own; offline they are spread over
+   * offlineWorkers, with output identical to the serial loop.
+   */
+  template <typename SampleType>
+  void processWetPath(Engine<SampleType> &engine,
+                      const SampleType *const *input, int numChannels,
+                      int numSubBlocks, int numSamples,
+                      VT2RDSP::SaturationQuality quality);
+
+  /**
+   * Refreshes the engine's preEmphasisCoeffs from its table.
+   * Called once per control slice (kCoefficientUpdateInterval samples);
+   * a steady Drive costs one compare.
    */
-  float processSaturation(float input, float drive);
+  template <typename SampleType>
+  void updatePreEmphasisCoefficients(Engine<SampleType> &engine,
+                                     SampleType drive);
 
   /**
-   * Mid Frequency Emphasis (1kHz - 3kHz)
-   * Boosts mids before saturation to create "Forward" character
+   * Saturator input gain (1x - 9x)
    */
-  float processPreEmphasis(float input, float drive, FilterState& state);
+  template <typename SampleType>
+  SampleType calculateSaturationGain(SampleType drive);
 
   /**
    * Automatic Makeup Gain
    */
-  float calculateMakeupGain(float drive);
+  template <typename SampleType>
+  SampleType calculateMakeupGain(SampleType drive);
 
   //==============================================================================
   // パラメータレイアウト作成
@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+    VT-2R - EMU AUDIO
+    Plugin State
+
+    Compact binary encoding of the plugin state (session save / recall).
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+
+namespace VT2RState {
+
+//==============================================================================
+/**
+ * Layout (little endian):
+ *
+ *   offset 0   uint32  kMagic ("VT2R")
+ *   offset 4   uint16  format version
+ *   offset 6   uint16  number of fields n
+ *   offset 8   n x float32, parameter values (denormalised), kParameterIds
+ *              order
+ *
+ * Fields are append-only: a parameter keeps its index in every version, new
+ * parameters go at the end. A reader takes the fields it knows and ignores
+ * the rest, so older blobs (fewer fields) leave the newer parameters as they
+ * are and newer blobs load in older builds. Blobs that do not start with
+ * kMagic are the XML state of earlier versions.
+ *
+ * Saving reads the parameter atomics and loading sets the parameters
+ * directly: no ValueTree copy, no XML.
+ */
+constexpr std::uint32_t kMagic = 0x52325456; // "VT2R" when read as bytes
+constexpr std::uint16_t kVersion = 1;
+constexpr int kHeaderSize = 8;
+
+// Field order - append only
+constexpr const char *kParameterIds[] = {"drive",
+                                         "mix",
+                                         "quality",
+                                         "oversampling",
+                                         "oversamplingFilter",
+                                         "antialiasing",
+                                         "character"};
+constexpr int kNumFields = int(std::size(kParameterIds));
+constexpr int kSize = kHeaderSize + kNumFields * 4;
+
+using Fields = std::array<float, kNumFields>;
+
+//==============================================================================
+namespace detail {
+inline void writeUint(std::uint8_t *dest, std::uint32_t value, int numBytes) {
+  for (int i = 0; i < numBytes; ++i)
+    dest[i] = std::uint8_t(value >> (8 * i));
+}
+
+inline std::uint32_t readUint(const std::uint8_t *source, int numBytes) {
+  std::uint32_t value = 0;
+  for (int i = 0; i < numBytes; ++i)
+    value |= std::uint32_t(source[i]) << (8 * i);
+  return value;
+}
+} // namespace detail
+
+/** Writes kSize bytes to dest. */
+inline void write(const Fields &fields, void *dest) {
+  auto *bytes = static_cast<std::uint8_t *>(dest);
+  detail::writeUint(bytes, kMagic, 4);
+  detail::writeUint(bytes + 4, kVersion, 2);
+  detail::writeUint(bytes + 6, std::uint32_t(kNumFields), 2);
+
+  for (int i = 0; i < kNumFields; ++i) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &fields[size_t(i)], 4);
+    detail::writeUint(bytes + kHeaderSize + 4 * i, bits, 4);
+  }
+}
+
+/** True if data starts with the binary header (otherwise: legacy XML). */
+inline bool isBinary(const void *data, int sizeInBytes) {
+  return data != nullptr && sizeInBytes >= kHeaderSize &&
+         detail::readUint(static_cast<const std::uint8_t *>(data), 4) ==
+             kMagic;
+}
+
+/**
+ * Reads the fields of a binary blob into fields. Returns the number of
+ * leading fields present (the others are left untouched), or -1 if the blob
+ * is truncated or holds a non-finite value; fields is then unchanged.
+ */
+inline int read(const void *data, int sizeInBytes, Fields &fields) {
+  if (!isBinary(data, sizeInBytes))
+    return -1;
+
+  const auto *bytes = static_cast<const std::uint8_t *>(data);
+  const int numStored = int(detail::readUint(bytes + 6, 2));
+  if (sizeInBytes < kHeaderSize + numStored * 4)
+    return -1;
+
+  const int numRead = numStored < kNumFields ? numStored : kNumFields;
+  Fields values = fields;
+
+  for (int i = 0; i < numRead; ++i) {
+    const auto bits = detail::readUint(bytes + kHeaderSize + 4 * i, 4);
+    std::memcpy(&values[size_t(i)], &bits, 4);
+    if (!std::isfinite(values[size_t(i)]))
+      return -1;
+  }
+
+  fields = values;
+  return numRead;
+}
+
+} // namespace VT2RState
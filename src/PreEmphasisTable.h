@@ -0,0 +1,250 @@
+/*
+  ==============================================================================
+    VT-2R - EMU AUDIO
+    Pre-Emphasis Coefficient Table
+
+    Drive → RBJ peaking EQ coefficients, precomputed per sample rate.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "SIMDVector.h"
+#include "SharedTableRegistry.h"
+#include "VT2RConstants.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace VT2RDSP {
+
+//==============================================================================
+/** Normalised biquad coefficients (a0 == 1) in the processing precision. */
+template <typename SampleType> struct BiquadCoefficients {
+  SampleType b0 = 1;
+  SampleType b1 = 0;
+  SampleType b2 = 0;
+  SampleType a1 = 0;
+  SampleType a2 = 0;
+};
+
+//==============================================================================
+/**
+ * A biquad over kBlockSize samples at once (state-space / look-ahead form).
+ * For an input block x[0 ... N-1] and the DF2 state z1, z2 at its start:
+ *
+ *   y[k] = sum(j <= k) h[k - j] x[j] + yz1[k] z1 + yz2[k] z2
+ *   w[k] = sum(j <= k) g[k - j] x[j] + wz1[k] z1 + wz2[k] z2
+ *
+ * h / g are the impulse responses of B(z)/A(z) and 1/A(z), yz / wz the
+ * responses to the initial state; the state after the block is
+ * z1 = w[N-1], z2 = w[N-2]. No output of the block depends on another, so
+ * one SIMD vector holds N consecutive samples (kBlockSize = the lane
+ * count: 8 float / 4 double with AVX, 4 / 2 with SSE/NEON).
+ *
+ * design() expands the coefficients in double and rounds once, so the
+ * block form differs from the sample-by-sample recursion by the rounding
+ * of its sums only.
+ */
+template <typename SampleType> struct BlockBiquadMatrices {
+  static constexpr int kBlockSize = SIMDRegister<SampleType>::kNumLanes;
+
+  SampleType h[kBlockSize], g[kBlockSize];
+  SampleType yz1[kBlockSize], yz2[kBlockSize];
+  SampleType wz1[kBlockSize], wz2[kBlockSize];
+
+  static BlockBiquadMatrices design(const BiquadCoefficients<SampleType> &c) {
+    const double b0 = double(c.b0), b1 = double(c.b1), b2 = double(c.b2);
+    const double a1 = double(c.a1), a2 = double(c.a2);
+
+    // Runs the DF2 recursion from (z1, z2) with input x0 at k = 0 only
+    auto respond = [&](double x0, double z1, double z2, SampleType *y,
+                       SampleType *w) {
+      for (int k = 0; k < kBlockSize; ++k) {
+        const double wk = (k == 0 ? x0 : 0.0) - a1 * z1 - a2 * z2;
+        if (y != nullptr)
+          y[k] = SampleType(b0 * wk + b1 * z1 + b2 * z2);
+        if (w != nullptr)
+          w[k] = SampleType(wk);
+        z2 = z1;
+        z1 = wk;
+      }
+    };
+
+    BlockBiquadMatrices m;
+    respond(1.0, 0.0, 0.0, m.h, m.g);
+    respond(0.0, 1.0, 0.0, m.yz1, m.wz1);
+    respond(0.0, 0.0, 1.0, m.yz2, m.wz2);
+    return m;
+  }
+};
+
+//==============================================================================
+/**
+ * Pre-Emphasis Coefficient Table
+ *
+ * The mid boost only depends on Drive (freq/Q are fixed), and Drive is a
+ * 0.1-step parameter, so every reachable steady-state coefficient set is
+ * computed once in prepare() - 1001 entries for 0.0 ... 100.0.
+ *
+ * Accuracy:
+ *  - Drive on the parameter grid (every steady state): bit-identical to the
+ *    former per-sample computation.
+ *  - Drive between grid points (only while smoothing): coefficients are
+ *    linearly interpolated between the neighbouring 0.1 steps. The resulting
+ *    emphasis gain differs from the exact filter by < 0.001 dB.
+ *
+ * SampleType is the processing precision: the double table keeps the
+ * coefficients as designed instead of rounding them to float.
+ *
+ * Every grid entry also has its BlockBiquadMatrices (lookupBlock), for the
+ * time-parallel mono kernel at a settled Drive.
+ *
+ * Processors take the table from getShared(), so every instance running
+ * at the same rate and precision reads one copy.
+ */
+template <typename SampleType> class PreEmphasisTable {
+public:
+  static constexpr int kStepsPerUnit = 10; // 1 / kDriveInterval
+  static constexpr int kNumEntries =
+      int(VT2RConstants::kDriveMax) * kStepsPerUnit + 1;
+
+  /** Builds the table for the given sample rate (allocates). */
+  void prepare(double sampleRate) {
+    entries.resize(size_t(kNumEntries));
+    blockEntries.resize(size_t(kNumEntries));
+
+    for (int i = 0; i < kNumEntries; ++i) {
+      entries[size_t(i)] = compute(SampleType(gridDrive(i)), sampleRate);
+      blockEntries[size_t(i)] =
+          BlockBiquadMatrices<SampleType>::design(entries[size_t(i)]);
+    }
+  }
+
+  bool isPrepared() const { return !entries.empty(); }
+
+  using Registry = SharedTableRegistry<double, PreEmphasisTable>;
+
+  /** Process-wide tables, one per sample rate. */
+  static Registry &getRegistry() {
+    static Registry registry;
+    return registry;
+  }
+
+  /**
+   * The shared table for sampleRate, built by the first caller at that
+   * rate. Locks and may allocate - prepare code only.
+   */
+  static std::shared_ptr<const PreEmphasisTable> getShared(double sampleRate) {
+    return getRegistry().acquire(sampleRate, [sampleRate] {
+      PreEmphasisTable table;
+      table.prepare(sampleRate);
+      return table;
+    });
+  }
+
+  /**
+   * Samples (at the table's rate) until the impulse response of the
+   * strongest boost has decayed by 100 dB, from the pole radius sqrt(a2).
+   */
+  double getTailSamples() const {
+    if (entries.empty())
+      return 0.0;
+
+    double radius = std::sqrt(std::abs(double(entries.back().a2)));
+    if (radius <= 0.0 || radius >= 1.0)
+      return 0.0;
+
+    return std::log(1.0e-5) / std::log(radius);
+  }
+
+  /** Drive value of grid entry i, rounded exactly like the parameter. */
+  static float gridDrive(int i) {
+    return VT2RConstants::kDriveMin + VT2RConstants::kDriveInterval * float(i);
+  }
+
+  /** Coefficients for any Drive value; exact entries on the 0.1 grid. */
+  BiquadCoefficients<SampleType> lookup(SampleType drive) const {
+    SampleType position =
+        std::clamp(drive, SampleType(VT2RConstants::kDriveMin),
+                   SampleType(VT2RConstants::kDriveMax)) *
+        SampleType(kStepsPerUnit);
+
+    int index = int(position);
+    SampleType frac = position - SampleType(index);
+
+    // Grid values land within float rounding of an integer position.
+    constexpr SampleType kGridSnap = SampleType(1.0e-3f);
+
+    if (frac < kGridSnap || index >= kNumEntries - 1)
+      return entries[size_t(std::min(index, kNumEntries - 1))];
+    if (frac > SampleType(1) - kGridSnap)
+      return entries[size_t(index + 1)];
+
+    const auto &lo = entries[size_t(index)];
+    const auto &hi = entries[size_t(index + 1)];
+
+    BiquadCoefficients<SampleType> c;
+    c.b0 = lo.b0 + frac * (hi.b0 - lo.b0);
+    c.b1 = lo.b1 + frac * (hi.b1 - lo.b1);
+    c.b2 = lo.b2 + frac * (hi.b2 - lo.b2);
+    c.a1 = lo.a1 + frac * (hi.a1 - lo.a1);
+    c.a2 = lo.a2 + frac * (hi.a2 - lo.a2);
+    return c;
+  }
+
+  /**
+   * Block form of the entry nearest to drive. Only for a settled Drive
+   * (always on the 0.1 grid); ramps interpolate between entries and use
+   * lookup().
+   */
+  const BlockBiquadMatrices<SampleType> &lookupBlock(SampleType drive) const {
+    const SampleType position =
+        std::clamp(drive, SampleType(VT2RConstants::kDriveMin),
+                   SampleType(VT2RConstants::kDriveMax)) *
+        SampleType(kStepsPerUnit);
+    return blockEntries[size_t(std::min(int(position + SampleType(0.5)),
+                                        kNumEntries - 1))];
+  }
+
+  /**
+   * Peaking EQ (RBJ Cookbook) at kPreEmphasisFreq / kPreEmphasisQ.
+   * Drive 0-100 -> Gain 0dB to +9dB
+   */
+  static BiquadCoefficients<SampleType> compute(SampleType drive,
+                                                double sampleRate) {
+    constexpr double kPi = 3.141592653589793238;
+
+    SampleType normDrive = drive / SampleType(100);
+    SampleType gainDb =
+        normDrive * SampleType(VT2RConstants::kMaxPreEmphasisGainDb);
+
+    double A = std::pow(10.0, gainDb / 40.0);
+    double w0 = 2.0 * kPi * VT2RConstants::kPreEmphasisFreq / sampleRate;
+    double alpha = std::sin(w0) / (2.0 * VT2RConstants::kPreEmphasisQ);
+
+    double b0 = 1.0 + alpha * A;
+    double b1 = -2.0 * std::cos(w0);
+    double b2 = 1.0 - alpha * A;
+    double a0 = 1.0 + alpha / A;
+    double a1 = -2.0 * std::cos(w0);
+    double a2 = 1.0 - alpha / A;
+
+    // Normalize by a0
+    BiquadCoefficients<SampleType> c;
+    c.b0 = SampleType(b0 / a0);
+    c.b1 = SampleType(b1 / a0);
+    c.b2 = SampleType(b2 / a0);
+    c.a1 = SampleType(a1 / a0);
+    c.a2 = SampleType(a2 / a0);
+    return c;
+  }
+
+private:
+  std::vector<BiquadCoefficients<SampleType>> entries;
+  std::vector<BlockBiquadMatrices<SampleType>> blockEntries;
+};
+
+} // namespace VT2RDSP
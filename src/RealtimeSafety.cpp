@@ -0,0 +1,171 @@
+/*
+  ==============================================================================
+    VT-2R - EMU AUDIO
+    Real-time safety instrumentation (VT2R_RT_WATCHDOG=1 builds only)
+
+    Counts heap operations and blocking calls made on a thread while it is
+    inside the audio callback (see AudioThreadWatchdog.h). Release builds
+    compile this file to nothing.
+  ==============================================================================
+*/
+
+#include "AudioThreadWatchdog.h"
+
+#if VT2R_RT_WATCHDOG
+
+#include <cstdlib>
+#include <new>
+
+#if defined(__linux__)
+#include <dlfcn.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Plain bool: constant-initialised, so safe to touch from operator new
+thread_local bool insideAudioCallback = false;
+
+std::atomic<uint32_t> heapOperations{0};
+std::atomic<uint32_t> blockingCalls{0};
+
+void noteHeapOperation() {
+  if (insideAudioCallback)
+    heapOperations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void noteBlockingCall() {
+  if (insideAudioCallback)
+    blockingCalls.fetch_add(1, std::memory_order_relaxed);
+}
+
+void *allocate(std::size_t size) {
+  noteHeapOperation();
+
+  if (void *pointer = std::malloc(size == 0 ? 1 : size))
+    return pointer;
+  throw std::bad_alloc();
+}
+
+void *allocateAligned(std::size_t size, std::align_val_t alignment) {
+  noteHeapOperation();
+
+  const auto align = static_cast<std::size_t>(alignment);
+  const std::size_t rounded = (size + align - 1) / align * align;
+#if defined(_WIN32)
+  void *pointer = _aligned_malloc(rounded == 0 ? align : rounded, align);
+#else
+  void *pointer = std::aligned_alloc(align, rounded == 0 ? align : rounded);
+#endif
+  if (pointer == nullptr)
+    throw std::bad_alloc();
+  return pointer;
+}
+
+void release(void *pointer) {
+  if (pointer == nullptr)
+    return;
+
+  noteHeapOperation();
+  std::free(pointer);
+}
+
+void releaseAligned(void *pointer) {
+  if (pointer == nullptr)
+    return;
+
+  noteHeapOperation();
+#if defined(_WIN32)
+  _aligned_free(pointer);
+#else
+  std::free(pointer);
+#endif
+}
+
+} // namespace
+
+namespace VT2RDSP::RealtimeSafety {
+void enterAudioCallback() { insideAudioCallback = true; }
+void leaveAudioCallback() { insideAudioCallback = false; }
+
+uint32_t getHeapOperationCount() {
+  return heapOperations.load(std::memory_order_relaxed);
+}
+
+uint32_t getBlockingCallCount() {
+  return blockingCalls.load(std::memory_order_relaxed);
+}
+} // namespace VT2RDSP::RealtimeSafety
+
+//==============================================================================
+// Replacement global allocation functions
+void *operator new(std::size_t size) { return allocate(size); }
+void *operator new[](std::size_t size) { return allocate(size); }
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  return allocateAligned(size, alignment);
+}
+void *operator new[](std::size_t size, std::align_val_t alignment) {
+  return allocateAligned(size, alignment);
+}
+
+void operator delete(void *pointer) noexcept { release(pointer); }
+void operator delete[](void *pointer) noexcept { release(pointer); }
+void operator delete(void *pointer, std::size_t) noexcept { release(pointer); }
+void operator delete[](void *pointer, std::size_t) noexcept {
+  release(pointer);
+}
+void operator delete(void *pointer, std::align_val_t) noexcept {
+  releaseAligned(pointer);
+}
+void operator delete[](void *pointer, std::align_val_t) noexcept {
+  releaseAligned(pointer);
+}
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept {
+  releaseAligned(pointer);
+}
+void operator delete[](void *pointer, std::size_t, std::align_val_t) noexcept {
+  releaseAligned(pointer);
+}
+
+//==============================================================================
+// Blocking calls (Linux: interposed, forwarded to the next definition)
+#if defined(__linux__)
+template <typename Function>
+Function findNext(const char *name) {
+  return reinterpret_cast<Function>(dlsym(RTLD_NEXT, name));
+}
+
+extern "C" {
+int pthread_mutex_lock(pthread_mutex_t *mutex) {
+  static const auto next =
+      findNext<int (*)(pthread_mutex_t *)>("pthread_mutex_lock");
+  noteBlockingCall();
+  return next(mutex);
+}
+
+int sem_wait(sem_t *semaphore) {
+  static const auto next = findNext<int (*)(sem_t *)>("sem_wait");
+  noteBlockingCall();
+  return next(semaphore);
+}
+
+int nanosleep(const struct timespec *duration, struct timespec *remaining) {
+  static const auto next =
+      findNext<int (*)(const struct timespec *, struct timespec *)>(
+          "nanosleep");
+  noteBlockingCall();
+  return next(duration, remaining);
+}
+
+int usleep(useconds_t microseconds) {
+  static const auto next = findNext<int (*)(useconds_t)>("usleep");
+  noteBlockingCall();
+  return next(microseconds);
+}
+} // extern "C"
+#endif
+
+#endif // VT2R_RT_WATCHDOG
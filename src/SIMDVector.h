@@ -0,0 +1,611 @@
+/*
+  ==============================================================================
+    VT-2R - EMU AUDIO
+    SIMD Vector
+
+    Minimal portable vector of float or double lanes (AVX / SSE2 / NEON /
+    scalar fallback). Lanes are used for channels: lane 0 = L, lane 1 = R, ...
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cmath>
+
+#if defined(__AVX__)
+#define VT2R_SIMD_AVX 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) ||                                  \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VT2R_SIMD_SSE 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define VT2R_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace VT2RDSP {
+
+//==============================================================================
+/**
+ * SIMD Register
+ *
+ * Only the handful of operations the kernels need. All loads/stores are
+ * unaligned so callers can use plain stack arrays.
+ *
+ * SampleType is float or double. The primary template is the portable
+ * scalar fallback (4 lanes); the specialisations below use AVX (8 float /
+ * 4 double lanes, enabled by the compiler flags, e.g. -mavx or /arch:AVX),
+ * SSE2 or NEON (4 float / 2 double lanes). Lane arithmetic is identical
+ * across backends, so the lane width never changes the output.
+ */
+template <typename SampleType> struct SIMDRegister {
+  static constexpr int kNumLanes = 4;
+  static constexpr int kAlignment = int(sizeof(SampleType)) * kNumLanes;
+
+  SampleType v[kNumLanes];
+
+  static SIMDRegister broadcast(SampleType x) { return {{x, x, x, x}}; }
+  static SIMDRegister load(const SampleType *p) {
+    return {{p[0], p[1], p[2], p[3]}};
+  }
+  void store(SampleType *p) const {
+    for (int i = 0; i < kNumLanes; ++i)
+      p[i] = v[i];
+  }
+  SampleType firstLane() const { return v[0]; }
+
+  template <typename Op>
+  static SIMDRegister map(SIMDRegister a, SIMDRegister b, Op op) {
+    SIMDRegister r;
+    for (int i = 0; i < kNumLanes; ++i)
+      r.v[i] = op(a.v[i], b.v[i]);
+    return r;
+  }
+
+  friend SIMDRegister operator+(SIMDRegister a, SIMDRegister b) {
+    return map(a, b, [](SampleType x, SampleType y) { return x + y; });
+  }
+  friend SIMDRegister operator-(SIMDRegister a, SIMDRegister b) {
+    return map(a, b, [](SampleType x, SampleType y) { return x - y; });
+  }
+  friend SIMDRegister operator*(SIMDRegister a, SIMDRegister b) {
+    return map(a, b, [](SampleType x, SampleType y) { return x * y; });
+  }
+  friend SIMDRegister operator/(SIMDRegister a, SIMDRegister b) {
+    return map(a, b, [](SampleType x, SampleType y) { return x / y; });
+  }
+  static SIMDRegister min(SIMDRegister a, SIMDRegister b) {
+    return map(a, b, [](SampleType x, SampleType y) { return y < x ? y : x; });
+  }
+  static SIMDRegister max(SIMDRegister a, SIMDRegister b) {
+    return map(a, b, [](SampleType x, SampleType y) { return x < y ? y : x; });
+  }
+  static SIMDRegister abs(SIMDRegister a) {
+    return map(a, a, [](SampleType x, SampleType) { return std::abs(x); });
+  }
+
+  /** Lanes with |x| < threshold become exactly 0. */
+  static SIMDRegister flushBelow(SIMDRegister a, SampleType threshold) {
+    return map(a, a, [threshold](SampleType x, SampleType) {
+      return std::abs(x) < threshold ? SampleType(0) : x;
+    });
+  }
+
+  /** Per lane: a < b ? x : y */
+  static SIMDRegister selectLess(SIMDRegister a, SIMDRegister b,
+                                 SIMDRegister x, SIMDRegister y) {
+    SIMDRegister r;
+    for (int i = 0; i < kNumLanes; ++i)
+      r.v[i] = a.v[i] < b.v[i] ? x.v[i] : y.v[i];
+    return r;
+  }
+  /** |magnitude| with the sign of sign. */
+  static SIMDRegister copySign(SIMDRegister magnitude, SIMDRegister sign) {
+    return map(magnitude, sign, [](SampleType x, SampleType y) {
+      return std::copysign(x, y);
+    });
+  }
+  /** Round to nearest integer value. */
+  static SIMDRegister round(SIMDRegister a) {
+    return map(a, a,
+               [](SampleType x, SampleType) { return std::nearbyint(x); });
+  }
+  /** a * 2^n for integer-valued n (no overflow handling). */
+  static SIMDRegister ldexp(SIMDRegister a, SIMDRegister n) {
+    return map(a, n, [](SampleType x, SampleType y) {
+      return std::ldexp(x, int(y));
+    });
+  }
+
+  static SIMDRegister zero() { return broadcast(SampleType(0)); }
+};
+
+#if VT2R_SIMD_AVX
+//==============================================================================
+template <> struct SIMDRegister<float> {
+  static constexpr int kNumLanes = 8;
+  static constexpr int kAlignment = int(sizeof(float)) * kNumLanes;
+
+  __m256 v;
+
+  static SIMDRegister broadcast(float x) { return {_mm256_set1_ps(x)}; }
+  static SIMDRegister load(const float *p) { return {_mm256_loadu_ps(p)}; }
+  void store(float *p) const { _mm256_storeu_ps(p, v); }
+  float firstLane() const { return _mm256_cvtss_f32(v); }
+
+  friend SIMDRegister operator+(SIMDRegister a, SIMDRegister b) {
+    return {_mm256_add_ps(a.v, b.v)};
+  }
+  friend SIMDRegister operator-(SIMDRegister a, SIMDRegister b) {
+    return {_mm256_sub_ps(a.v, b.v)};
+  }
+  friend SIMDRegister operator*(SIMDRegister a, SIMDRegister b) {
+    return {_mm256_mul_ps(a.v, b.v)};
+  }
+  friend SIMDRegister operator/(SIMDRegister a, SIMDRegister b) {
+    return {_mm256_div_ps(a.v, b.v)};
+  }
+  static SIMDRegister min(SIMDRegister a, SIMDRegister b) {
+    return {_mm256_min_ps(a.v, b.v)};
+  }
+  static SIMDRegister max(SIMDRegister a, SIMDRegister b) {
+    return {_mm256_max_ps(a.v, b.v)};
+  }
+  static SIMDRegister abs(SIMDRegister a) {
+    return {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v)};
+  }
+
+  static SIMDRegister flushBelow(SIMDRegister a, float threshold) {
+    return {_mm256_and_ps(
+        a.v, _mm256_cmp_ps(abs(a).v, _mm256_set1_ps(threshold), _CMP_GE_OQ))};
+  }
+
+  static SIMDRegister selectLess(SIMDRegister a, SIMDRegister b,
+                                 SIMDRegister x, SIMDRegister y) {
+    return {_mm256_blendv_ps(y.v, x.v, _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ))};
+  }
+  static SIMDRegister copySign(SIMDRegister magnitude, SIMDRegister sign) {
+    __m256 signBit = _mm256_set1_ps(-0.0f);
+    return {_mm256_or_ps(_mm256_andnot_ps(signBit, magnitude.v),
+                         _mm256_and_ps(signBit, sign.v))};
+  }
+  static SIMDRegister round(SIMDRegister a) {
+    return {
+        _mm256_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)};
+  }
+  /** AVX has no 256-bit integer adds - the exponent is added per half. */
+  static SIMDRegister ldexp(SIMDRegister a, SIMDRegister n) {
+    __m256i e = _mm256_cvtps_epi32(n.v);
+    __m256i bits = _mm256_castps_si256(a.v);
+    __m128i lo = _mm_add_epi32(
+        _mm256_castsi256_si128(bits),
+        _mm_slli_epi32(_mm256_castsi256_si128(e), 23));
+    __m128i hi = _mm_add_epi32(
+        _mm256_extractf128_si256(bits, 1),
+        _mm_slli_epi32(_mm256_extractf128_si256(e, 1), 23));
+    return {_mm256_castsi256_ps(
+        _mm256_insertf128_si256(_mm256_castsi128_si256(lo), hi, 1))};
+  }
+
+  static SIMDRegister zero() { return broadcast(0.0f); }
+};
+
+template <> struct SIMDRegister<double> {
+  static constexpr int kNumLanes = 4;
+  static constexpr int kAlignment = int(sizeof(double)) * kNumLanes;
+
+  __m256d v;
+
+  static SIMDRegister broadcast(double x) { return {_mm256_set1_pd(x)}; }
+  static SIMDRegister load(const double *p) { return {_mm256_loadu_pd(p)}; }
+  void store(double *p) const { _mm256_storeu_pd(p, v); }
+  double firstLane() const { return _mm256_cvtsd_f64(v); }
+
+  friend SIMDRegister operator+(SIMDRegister a, SIMDRegister b) {
+    return {_mm256_add_pd(a.v, b.v)};
+  }
+  friend SIMDRegister operator-(SIMDRegister a, SIMDRegister b) {
+    return {_mm256_sub_pd(a.v, b.v)};
+  }
+  friend SIMDRegister operator*(SIMDRegister a, SIMDRegister b) {
+    return {_mm256_mul_pd(a.v, b.v)};
+  }
+  friend SIMDRegister operator/(SIMDRegister a, SIMDRegister b) {
+    return {_mm256_div_pd(a.v, b.v)};
+  }
+  static SIMDRegister min(SIMDRegister a, SIMDRegister b) {
+    return {_mm256_min_pd(a.v, b.v)};
+  }
+  static SIMDRegister max(SIMDRegister a, SIMDRegister b) {
+    return {_mm256_max_pd(a.v, b.v)};
+  }
+  static SIMDRegister abs(SIMDRegister a) {
+    return {_mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v)};
+  }
+
+  static SIMDRegister flushBelow(SIMDRegister a, double threshold) {
+    return {_mm256_and_pd(
+        a.v, _mm256_cmp_pd(abs(a).v, _mm256_set1_pd(threshold), _CMP_GE_OQ))};
+  }
+
+  static SIMDRegister selectLess(SIMDRegister a, SIMDRegister b,
+                                 SIMDRegister x, SIMDRegister y) {
+    return {_mm256_blendv_pd(y.v, x.v, _mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ))};
+  }
+  static SIMDRegister copySign(SIMDRegister magnitude, SIMDRegister sign) {
+    __m256d signBit = _mm256_set1_pd(-0.0);
+    return {_mm256_or_pd(_mm256_andnot_pd(signBit, magnitude.v),
+                         _mm256_and_pd(signBit, sign.v))};
+  }
+  static SIMDRegister round(SIMDRegister a) {
+    return {
+        _mm256_round_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)};
+  }
+  /** Exponents widened to 64 bits and added per 128-bit half. */
+  static SIMDRegister ldexp(SIMDRegister a, SIMDRegister n) {
+    __m128i e = _mm256_cvtpd_epi32(n.v);
+    __m256i bits = _mm256_castpd_si256(a.v);
+    __m128i lo = _mm_add_epi64(_mm256_castsi256_si128(bits),
+                               _mm_slli_epi64(_mm_cvtepi32_epi64(e), 52));
+    __m128i hi = _mm_add_epi64(
+        _mm256_extractf128_si256(bits, 1),
+        _mm_slli_epi64(_mm_cvtepi32_epi64(_mm_srli_si128(e, 8)), 52));
+    return {_mm256_castsi256_pd(
+        _mm256_insertf128_si256(_mm256_castsi128_si256(lo), hi, 1))};
+  }
+
+  static SIMDRegister zero() { return broadcast(0.0); }
+};
+
+#elif VT2R_SIMD_SSE
+//==============================================================================
+template <> struct SIMDRegister<float> {
+  static constexpr int kNumLanes = 4;
+  static constexpr int kAlignment = int(sizeof(float)) * kNumLanes;
+
+  __m128 v;
+
+  static SIMDRegister broadcast(float x) { return {_mm_set1_ps(x)}; }
+  static SIMDRegister load(const float *p) { return {_mm_loadu_ps(p)}; }
+  void store(float *p) const { _mm_storeu_ps(p, v); }
+  float firstLane() const { return _mm_cvtss_f32(v); }
+
+  friend SIMDRegister operator+(SIMDRegister a, SIMDRegister b) {
+    return {_mm_add_ps(a.v, b.v)};
+  }
+  friend SIMDRegister operator-(SIMDRegister a, SIMDRegister b) {
+    return {_mm_sub_ps(a.v, b.v)};
+  }
+  friend SIMDRegister operator*(SIMDRegister a, SIMDRegister b) {
+    return {_mm_mul_ps(a.v, b.v)};
+  }
+  friend SIMDRegister operator/(SIMDRegister a, SIMDRegister b) {
+    return {_mm_div_ps(a.v, b.v)};
+  }
+  static SIMDRegister min(SIMDRegister a, SIMDRegister b) {
+    return {_mm_min_ps(a.v, b.v)};
+  }
+  static SIMDRegister max(SIMDRegister a, SIMDRegister b) {
+    return {_mm_max_ps(a.v, b.v)};
+  }
+  static SIMDRegister abs(SIMDRegister a) {
+    return {_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v)};
+  }
+
+  static SIMDRegister flushBelow(SIMDRegister a, float threshold) {
+    return {_mm_and_ps(a.v, _mm_cmpge_ps(abs(a).v, _mm_set1_ps(threshold)))};
+  }
+
+  static SIMDRegister selectLess(SIMDRegister a, SIMDRegister b,
+                                 SIMDRegister x, SIMDRegister y) {
+    __m128 mask = _mm_cmplt_ps(a.v, b.v);
+    return {_mm_or_ps(_mm_and_ps(mask, x.v), _mm_andnot_ps(mask, y.v))};
+  }
+  static SIMDRegister copySign(SIMDRegister magnitude, SIMDRegister sign) {
+    __m128 signBit = _mm_set1_ps(-0.0f);
+    return {_mm_or_ps(_mm_andnot_ps(signBit, magnitude.v),
+                      _mm_and_ps(signBit, sign.v))};
+  }
+  static SIMDRegister round(SIMDRegister a) {
+    return {_mm_cvtepi32_ps(_mm_cvtps_epi32(a.v))};
+  }
+  static SIMDRegister ldexp(SIMDRegister a, SIMDRegister n) {
+    __m128i e = _mm_slli_epi32(_mm_cvtps_epi32(n.v), 23);
+    return {_mm_castsi128_ps(_mm_add_epi32(_mm_castps_si128(a.v), e))};
+  }
+
+  static SIMDRegister zero() { return broadcast(0.0f); }
+};
+
+template <> struct SIMDRegister<double> {
+  static constexpr int kNumLanes = 2;
+  static constexpr int kAlignment = int(sizeof(double)) * kNumLanes;
+
+  __m128d v;
+
+  static SIMDRegister broadcast(double x) { return {_mm_set1_pd(x)}; }
+  static SIMDRegister load(const double *p) { return {_mm_loadu_pd(p)}; }
+  void store(double *p) const { _mm_storeu_pd(p, v); }
+  double firstLane() const { return _mm_cvtsd_f64(v); }
+
+  friend SIMDRegister operator+(SIMDRegister a, SIMDRegister b) {
+    return {_mm_add_pd(a.v, b.v)};
+  }
+  friend SIMDRegister operator-(SIMDRegister a, SIMDRegister b) {
+    return {_mm_sub_pd(a.v, b.v)};
+  }
+  friend SIMDRegister operator*(SIMDRegister a, SIMDRegister b) {
+    return {_mm_mul_pd(a.v, b.v)};
+  }
+  friend SIMDRegister operator/(SIMDRegister a, SIMDRegister b) {
+    return {_mm_div_pd(a.v, b.v)};
+  }
+  static SIMDRegister min(SIMDRegister a, SIMDRegister b) {
+    return {_mm_min_pd(a.v, b.v)};
+  }
+  static SIMDRegister max(SIMDRegister a, SIMDRegister b) {
+    return {_mm_max_pd(a.v, b.v)};
+  }
+  static SIMDRegister abs(SIMDRegister a) {
+    return {_mm_andnot_pd(_mm_set1_pd(-0.0), a.v)};
+  }
+
+  static SIMDRegister flushBelow(SIMDRegister a, double threshold) {
+    return {_mm_and_pd(a.v, _mm_cmpge_pd(abs(a).v, _mm_set1_pd(threshold)))};
+  }
+
+  static SIMDRegister selectLess(SIMDRegister a, SIMDRegister b,
+                                 SIMDRegister x, SIMDRegister y) {
+    __m128d mask = _mm_cmplt_pd(a.v, b.v);
+    return {_mm_or_pd(_mm_and_pd(mask, x.v), _mm_andnot_pd(mask, y.v))};
+  }
+  static SIMDRegister copySign(SIMDRegister magnitude, SIMDRegister sign) {
+    __m128d signBit = _mm_set1_pd(-0.0);
+    return {_mm_or_pd(_mm_andnot_pd(signBit, magnitude.v),
+                      _mm_and_pd(signBit, sign.v))};
+  }
+  static SIMDRegister round(SIMDRegister a) {
+    return {_mm_cvtepi32_pd(_mm_cvtpd_epi32(a.v))};
+  }
+  /** SSE2 only converts to 32-bit integers - sign extended to 64 here. */
+  static SIMDRegister ldexp(SIMDRegister a, SIMDRegister n) {
+    __m128i e = _mm_cvtpd_epi32(n.v);
+    e = _mm_unpacklo_epi32(e, _mm_srai_epi32(e, 31));
+    return {_mm_castsi128_pd(
+        _mm_add_epi64(_mm_castpd_si128(a.v), _mm_slli_epi64(e, 52)))};
+  }
+
+  static SIMDRegister zero() { return broadcast(0.0); }
+};
+
+#elif VT2R_SIMD_NEON
+//==============================================================================
+template <> struct SIMDRegister<float> {
+  static constexpr int kNumLanes = 4;
+  static constexpr int kAlignment = int(sizeof(float)) * kNumLanes;
+
+  float32x4_t v;
+
+  static SIMDRegister broadcast(float x) { return {vdupq_n_f32(x)}; }
+  static SIMDRegister load(const float *p) { return {vld1q_f32(p)}; }
+  void store(float *p) const { vst1q_f32(p, v); }
+  float firstLane() const { return vgetq_lane_f32(v, 0); }
+
+  friend SIMDRegister operator+(SIMDRegister a, SIMDRegister b) {
+    return {vaddq_f32(a.v, b.v)};
+  }
+  friend SIMDRegister operator-(SIMDRegister a, SIMDRegister b) {
+    return {vsubq_f32(a.v, b.v)};
+  }
+  friend SIMDRegister operator*(SIMDRegister a, SIMDRegister b) {
+    return {vmulq_f32(a.v, b.v)};
+  }
+  friend SIMDRegister operator/(SIMDRegister a, SIMDRegister b) {
+    return {vdivq_f32(a.v, b.v)};
+  }
+  static SIMDRegister min(SIMDRegister a, SIMDRegister b) {
+    return {vminq_f32(a.v, b.v)};
+  }
+  static SIMDRegister max(SIMDRegister a, SIMDRegister b) {
+    return {vmaxq_f32(a.v, b.v)};
+  }
+  static SIMDRegister abs(SIMDRegister a) { return {vabsq_f32(a.v)}; }
+
+  static SIMDRegister flushBelow(SIMDRegister a, float threshold) {
+    uint32x4_t keep = vcgeq_f32(vabsq_f32(a.v), vdupq_n_f32(threshold));
+    return {vreinterpretq_f32_u32(
+        vandq_u32(vreinterpretq_u32_f32(a.v), keep))};
+  }
+
+  static SIMDRegister selectLess(SIMDRegister a, SIMDRegister b,
+                                 SIMDRegister x, SIMDRegister y) {
+    return {vbslq_f32(vcltq_f32(a.v, b.v), x.v, y.v)};
+  }
+  static SIMDRegister copySign(SIMDRegister magnitude, SIMDRegister sign) {
+    return {vbslq_f32(vdupq_n_u32(0x80000000u), sign.v, magnitude.v)};
+  }
+  static SIMDRegister round(SIMDRegister a) { return {vrndnq_f32(a.v)}; }
+  static SIMDRegister ldexp(SIMDRegister a, SIMDRegister n) {
+    int32x4_t e = vshlq_n_s32(vcvtq_s32_f32(n.v), 23);
+    return {vreinterpretq_f32_s32(vaddq_s32(vreinterpretq_s32_f32(a.v), e))};
+  }
+
+  static SIMDRegister zero() { return broadcast(0.0f); }
+};
+
+template <> struct SIMDRegister<double> {
+  static constexpr int kNumLanes = 2;
+  static constexpr int kAlignment = int(sizeof(double)) * kNumLanes;
+
+  float64x2_t v;
+
+  static SIMDRegister broadcast(double x) { return {vdupq_n_f64(x)}; }
+  static SIMDRegister load(const double *p) { return {vld1q_f64(p)}; }
+  void store(double *p) const { vst1q_f64(p, v); }
+  double firstLane() const { return vgetq_lane_f64(v, 0); }
+
+  friend SIMDRegister operator+(SIMDRegister a, SIMDRegister b) {
+    return {vaddq_f64(a.v, b.v)};
+  }
+  friend SIMDRegister operator-(SIMDRegister a, SIMDRegister b) {
+    return {vsubq_f64(a.v, b.v)};
+  }
+  friend SIMDRegister operator*(SIMDRegister a, SIMDRegister b) {
+    return {vmulq_f64(a.v, b.v)};
+  }
+  friend SIMDRegister operator/(SIMDRegister a, SIMDRegister b) {
+    return {vdivq_f64(a.v, b.v)};
+  }
+  static SIMDRegister min(SIMDRegister a, SIMDRegister b) {
+    return {vminq_f64(a.v, b.v)};
+  }
+  static SIMDRegister max(SIMDRegister a, SIMDRegister b) {
+    return {vmaxq_f64(a.v, b.v)};
+  }
+  static SIMDRegister abs(SIMDRegister a) { return {vabsq_f64(a.v)}; }
+
+  static SIMDRegister flushBelow(SIMDRegister a, double threshold) {
+    uint64x2_t keep = vcgeq_f64(vabsq_f64(a.v), vdupq_n_f64(threshold));
+    return {vreinterpretq_f64_u64(
+        vandq_u64(vreinterpretq_u64_f64(a.v), keep))};
+  }
+
+  static SIMDRegister selectLess(SIMDRegister a, SIMDRegister b,
+                                 SIMDRegister x, SIMDRegister y) {
+    return {vbslq_f64(vcltq_f64(a.v, b.v), x.v, y.v)};
+  }
+  static SIMDRegister copySign(SIMDRegister magnitude, SIMDRegister sign) {
+    return {vbslq_f64(vdupq_n_u64(0x8000000000000000ull), sign.v,
+                      magnitude.v)};
+  }
+  static SIMDRegister round(SIMDRegister a) { return {vrndnq_f64(a.v)}; }
+  static SIMDRegister ldexp(SIMDRegister a, SIMDRegister n) {
+    int64x2_t e = vshlq_n_s64(vcvtq_s64_f64(n.v), 52);
+    return {vreinterpretq_f64_s64(vaddq_s64(vreinterpretq_s64_f64(a.v), e))};
+  }
+
+  static SIMDRegister zero() { return broadcast(0.0); }
+};
+#endif
+
+/** Float lanes (the plugin's default processing precision). */
+using SIMDVector = SIMDRegister<float>;
+
+//==============================================================================
+// Channel-interleaved lane buffers: one SIMDRegister per sample, channel
+// firstChannel + l in lane l. Channels are processed in groups of kNumLanes.
+
+template <typename SampleType> inline int getNumLaneGroups(int numChannels) {
+  constexpr int kNumLanes = SIMDRegister<SampleType>::kNumLanes;
+  return (numChannels + kNumLanes - 1) / kNumLanes;
+}
+
+/**
+ * Planar channels [firstChannel, firstChannel + count) -> lanes. Lanes
+ * without a channel are zero.
+ *
+ * NumChannels > 0 fixes count at compile time: mono and stereo groups are
+ * built with broadcasts and blends in registers, without the per-sample
+ * channel loop and the trip through memory of the general case.
+ */
+template <int NumChannels = 0, typename SampleType>
+inline void interleaveLanes(const SampleType *const *channels,
+                            int firstChannel, int count, int numSamples,
+                            SIMDRegister<SampleType> *lanes) {
+  using V = SIMDRegister<SampleType>;
+  static_assert(NumChannels <= V::kNumLanes, "more channels than lanes");
+
+  if constexpr (NumChannels == 1 || NumChannels == 2) {
+    alignas(V::kAlignment) SampleType laneIndices[V::kNumLanes];
+    for (int l = 0; l < V::kNumLanes; ++l)
+      laneIndices[l] = SampleType(l);
+
+    const auto index = V::load(laneIndices);
+    const auto one = V::broadcast(SampleType(1));
+    const auto two = V::broadcast(SampleType(2));
+    const SampleType *left = channels[firstChannel];
+
+    if constexpr (NumChannels == 1) {
+      for (int i = 0; i < numSamples; ++i)
+        lanes[i] = V::selectLess(index, one, V::broadcast(left[i]), V::zero());
+    } else {
+      const SampleType *right = channels[firstChannel + 1];
+      for (int i = 0; i < numSamples; ++i)
+        lanes[i] = V::selectLess(
+            index, one, V::broadcast(left[i]),
+            V::selectLess(index, two, V::broadcast(right[i]), V::zero()));
+    }
+  } else {
+    alignas(V::kAlignment) SampleType frame[V::kNumLanes] = {};
+    const int numLanes = NumChannels > 0 ? NumChannels : count;
+
+    for (int i = 0; i < numSamples; ++i) {
+      for (int l = 0; l < numLanes; ++l)
+        frame[l] = channels[firstChannel + l][i];
+      lanes[i] = V::load(frame);
+    }
+  }
+}
+
+/**
+ * Lanes -> planar channels [firstChannel, firstChannel + count).
+ * NumChannels > 0 fixes count at compile time (unrolled channel loop).
+ */
+template <int NumChannels = 0, typename SampleType>
+inline void deinterleaveLanes(const SIMDRegister<SampleType> *lanes,
+                              SampleType *const *channels, int firstChannel,
+                              int count, int numSamples) {
+  using V = SIMDRegister<SampleType>;
+  static_assert(NumChannels <= V::kNumLanes, "more channels than lanes");
+
+  alignas(V::kAlignment) SampleType frame[V::kNumLanes];
+  const int numLanes = NumChannels > 0 ? NumChannels : count;
+
+  for (int i = 0; i < numSamples; ++i) {
+    lanes[i].store(frame);
+    for (int l = 0; l < numLanes; ++l)
+      channels[firstChannel + l][i] = frame[l];
+  }
+}
+
+/**
+ * interleaveLanes / deinterleaveLanes for one lane group, with the mono
+ * and stereo specialisations picked once per call from count.
+ */
+template <typename SampleType>
+inline void interleaveLaneGroup(const SampleType *const *channels,
+                                int firstChannel, int count, int numSamples,
+                                SIMDRegister<SampleType> *lanes) {
+  switch (count) {
+  case 1:
+    interleaveLanes<1>(channels, firstChannel, count, numSamples, lanes);
+    break;
+  case 2:
+    interleaveLanes<2>(channels, firstChannel, count, numSamples, lanes);
+    break;
+  default:
+    interleaveLanes(channels, firstChannel, count, numSamples, lanes);
+    break;
+  }
+}
+
+template <typename SampleType>
+inline void deinterleaveLaneGroup(const SIMDRegister<SampleType> *lanes,
+                                  SampleType *const *channels,
+                                  int firstChannel, int count,
+                                  int numSamples) {
+  switch (count) {
+  case 1:
+    deinterleaveLanes<1>(lanes, channels, firstChannel, count, numSamples);
+    break;
+  case 2:
+    deinterleaveLanes<2>(lanes, channels, firstChannel, count, numSamples);
+    break;
+  default:
+    deinterleaveLanes(lanes, channels, firstChannel, count, numSamples);
+    break;
+  }
+}
+
+} // namespace VT2RDSP
@@ -0,0 +1,212 @@
+/*
+  ==============================================================================
+    VT-2R - EMU AUDIO
+    Saturation Functions
+
+    tanh implementations with bounded error, scalar and SIMDRegister.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "SIMDVector.h"
+
+#include <array>
+#include <cmath>
+#include <type_traits>
+
+namespace VT2RDSP {
+
+//==============================================================================
+/**
+ * Saturator accuracy tiers (the "quality" parameter).
+ *
+ * Max absolute error against std::tanh (double), measured over [-20, 20]:
+ *
+ *  | Tier    | Implementation                   | Max error |
+ *  |---------|----------------------------------|-----------|
+ *  | (ref)   | std::tanh in float               | 1.1e-7    |
+ *  | Eco     | TanhRational  (Pade [7/6])       | 9.6e-5    |
+ *  | Normal  | TanhTable     (LUT, linear)      | 6.0e-6    |
+ *  | Precise | TanhPolynomial (range-reduced)   | 1.3e-7    |
+ *
+ * kMaxError holds each tier's bound; `vt2r_compare` sweeps every tier,
+ * scalar and in float / double lanes, and fails when one exceeds it.
+ *
+ * Every implementation provides a float overload of operator() and one for
+ * SIMDRegister<float> / SIMDRegister<double>, so the lane kernel is
+ * templated on the saturator type. The double lanes evaluate the same
+ * approximations (constants as above); only the rounding is finer.
+ */
+enum class SaturationQuality { Eco = 0, Normal, Precise };
+
+//==============================================================================
+/**
+ * Lambert continued fraction truncated to a [7/6] rational.
+ * Clamped at +-4.97 where the rational reaches 1.
+ */
+struct TanhRational {
+  static constexpr float kClamp = 4.97f;
+  static constexpr double kMaxError = 9.6e-5;
+
+  float operator()(float x) const {
+    x = x < -kClamp ? -kClamp : (x > kClamp ? kClamp : x);
+    float x2 = x * x;
+    float num = x * (135135.0f + x2 * (17325.0f + x2 * (378.0f + x2)));
+    float den = 135135.0f + x2 * (62370.0f + x2 * (3150.0f + x2 * 28.0f));
+    return num / den;
+  }
+
+  template <typename SampleType>
+  SIMDRegister<SampleType> operator()(SIMDRegister<SampleType> x) const {
+    using V = SIMDRegister<SampleType>;
+    x = V::min(V::max(x, V::broadcast(-kClamp)), V::broadcast(kClamp));
+    auto x2 = x * x;
+    auto num =
+        x * (V::broadcast(135135.0f) +
+             x2 * (V::broadcast(17325.0f) +
+                   x2 * (V::broadcast(378.0f) + x2)));
+    auto den = V::broadcast(135135.0f) +
+               x2 * (V::broadcast(62370.0f) +
+                     x2 * (V::broadcast(3150.0f) +
+                           x2 * V::broadcast(28.0f)));
+    return num / den;
+  }
+};
+
+//==============================================================================
+/**
+ * tanh(|x|) = (1 - e) / (1 + e), e = exp(-2|x|).
+ * exp is range reduced (2^n * exp(r), |r| <= ln2/2) and evaluated with a
+ * degree-6 polynomial. Below |x| = 0.55 the [7/6] rational is used instead,
+ * which avoids the cancellation in 1 - e.
+ */
+struct TanhPolynomial {
+  static constexpr float kSmall = 0.55f;
+  static constexpr float kLarge = 9.0f; // tanh == 1.0f beyond this
+  static constexpr double kMaxError = 1.3e-7;
+
+  static constexpr float kLog2e = 1.44269504088896341f;
+  static constexpr float kLn2Hi = 0.693145751953125f;
+  static constexpr float kLn2Lo = 1.42860682030941723212e-6f;
+
+  float operator()(float x) const {
+    float ax = std::abs(x);
+    if (ax < kSmall)
+      return TanhRational()(x);
+
+    ax = ax < kLarge ? ax : kLarge;
+    float y = -2.0f * ax;
+    float n = std::nearbyint(y * kLog2e);
+    float r = (y - n * kLn2Hi) - n * kLn2Lo;
+    float e = std::ldexp(expPolynomial(r), int(n));
+    return std::copysign((1.0f - e) / (1.0f + e), x);
+  }
+
+  template <typename SampleType>
+  SIMDRegister<SampleType> operator()(SIMDRegister<SampleType> x) const {
+    using V = SIMDRegister<SampleType>;
+    auto ax = V::min(V::abs(x), V::broadcast(kLarge));
+    auto y = V::broadcast(-2.0f) * ax;
+    auto n = V::round(y * V::broadcast(kLog2e));
+    auto r = (y - n * V::broadcast(kLn2Hi)) - n * V::broadcast(kLn2Lo);
+    auto e = V::ldexp(expPolynomial(r), n);
+    auto one = V::broadcast(1.0f);
+    auto large = V::copySign((one - e) / (one + e), x);
+    return V::selectLess(ax, V::broadcast(kSmall), TanhRational()(x), large);
+  }
+
+private:
+  // Taylor series of exp(r) to r^6 (|r| <= 0.347 -> rel. error < 1e-9)
+  template <typename T> static T expPolynomial(T r) {
+    auto c = [](float k) {
+      if constexpr (std::is_same_v<T, float>)
+        return k;
+      else
+        return T::broadcast(k);
+    };
+    return c(1.0f) +
+           r * (c(1.0f) +
+                r * (c(1.0f / 2.0f) +
+                     r * (c(1.0f / 6.0f) +
+                          r * (c(1.0f / 24.0f) +
+                               r * (c(1.0f / 120.0f) +
+                                    r * c(1.0f / 720.0f))))));
+  }
+};
+
+//==============================================================================
+/**
+ * Linearly interpolated lookup table over [0, kRange], odd symmetric.
+ * The vector overload interpolates in lanes; only the two table reads
+ * per lane are scalar.
+ */
+struct TanhTable {
+  static constexpr int kSize = 1024;
+  static constexpr float kRange = 8.0f;
+  static constexpr float kScale = float(kSize) / kRange;
+  static constexpr double kMaxError = 6.0e-6;
+
+  using Table = std::array<float, kSize + 2>;
+
+  /** Shared table, built on first call (call once from prepareToPlay). */
+  static const Table &getTable() {
+    static const Table table = [] {
+      Table t{};
+      for (int i = 0; i < kSize + 2; ++i)
+        t[size_t(i)] = float(std::tanh(double(i) / double(kScale)));
+      return t;
+    }();
+    return table;
+  }
+
+  const Table &table = getTable();
+
+  float operator()(float x) const {
+    float pos = std::abs(x) * kScale;
+    pos = pos < float(kSize) ? pos : float(kSize);
+    int i = int(pos);
+    float frac = pos - float(i);
+    float y = table[size_t(i)] + frac * (table[size_t(i + 1)] - table[size_t(i)]);
+    return std::copysign(y, x);
+  }
+
+  template <typename SampleType>
+  SIMDRegister<SampleType> operator()(SIMDRegister<SampleType> x) const {
+    using V = SIMDRegister<SampleType>;
+    auto pos = V::min(V::abs(x) * V::broadcast(kScale),
+                      V::broadcast(SampleType(kSize)));
+
+    alignas(V::kAlignment) SampleType p[V::kNumLanes], lo[V::kNumLanes],
+        hi[V::kNumLanes];
+    pos.store(p);
+    for (int lane = 0; lane < V::kNumLanes; ++lane) {
+      int i = int(p[lane]);
+      p[lane] = SampleType(i);
+      lo[lane] = table[size_t(i)];
+      hi[lane] = table[size_t(i + 1)];
+    }
+
+    auto frac = pos - V::load(p);
+    auto a = V::load(lo);
+    return V::copySign(a + frac * (V::load(hi) - a), x);
+  }
+};
+
+//==============================================================================
+/** std::tanh per lane - the original saturator, kept as the reference. */
+struct TanhReference {
+  float operator()(float x) const { return std::tanh(x); }
+
+  template <typename SampleType>
+  SIMDRegister<SampleType> operator()(SIMDRegister<SampleType> x) const {
+    using V = SIMDRegister<SampleType>;
+    alignas(V::kAlignment) SampleType lanes[V::kNumLanes];
+    x.store(lanes);
+    for (auto &lane : lanes)
+      lane = std::tanh(lane);
+    return V::load(lanes);
+  }
+};
+
+} // namespace VT2RDSP
@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+    VT-2R - EMU AUDIO
+    Shared Table Registry
+
+    Read-only DSP tables shared by every processor instance in the process.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace VT2RDSP {
+
+//==============================================================================
+/**
+ * Process-wide cache of immutable tables, keyed by whatever determines
+ * their contents (sample rate, filter design, ...).
+ *
+ * The first acquire() for a key builds the table; later ones return the
+ * same object. The registry only holds weak references, so a table lives
+ * as long as some instance holds it and is freed with the last one - a
+ * session at one rate keeps one copy however many instances it runs.
+ *
+ * Thread-safe; acquire() locks and may allocate, so call it from prepare
+ * code, never from the audio thread. Holders only read through the
+ * returned pointer (no reference counting while processing).
+ */
+template <typename Key, typename Table> class SharedTableRegistry {
+public:
+  /** build() returns the Table for key; called at most once per live key. */
+  template <typename Build>
+  std::shared_ptr<const Table> acquire(const Key &key, Build &&build) {
+    const std::lock_guard<std::mutex> lock(mutex);
+
+    // Tables whose last holder has gone
+    for (auto it = tables.begin(); it != tables.end();)
+      it = it->second.expired() ? tables.erase(it) : std::next(it);
+
+    auto &slot = tables[key];
+    if (auto table = slot.lock())
+      return table;
+
+    auto table = std::make_shared<const Table>(build());
+    slot = table;
+    return table;
+  }
+
+  /** Tables currently alive (statistics / tests). */
+  int getNumTables() {
+    const std::lock_guard<std::mutex> lock(mutex);
+
+    int count = 0;
+    for (const auto &entry : tables)
+      count += entry.second.expired() ? 0 : 1;
+    return count;
+  }
+
+private:
+  std::mutex mutex;
+  std::map<Key, std::weak_ptr<const Table>> tables;
+};
+
+} // namespace VT2RDSP
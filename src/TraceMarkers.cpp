@@ -0,0 +1,274 @@
+/*
+  ==============================================================================
+    VT-2R - EMU AUDIO
+    Trace marker recording and Chrome trace-event export
+    (VT2R_TRACE=1 builds only)
+
+    Per-thread lock-free event rings, drained by a writer thread into a JSON
+    trace file (see TraceMarkers.h). Release builds compile this file to
+    nothing.
+  ==============================================================================
+*/
+
+#include "TraceMarkers.h"
+
+#if VT2R_TRACE
+
+#include <juce_events/juce_events.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+
+struct Event {
+  const char *name;
+  std::int64_t begin, end; // ns
+};
+
+/**
+ * One thread's events: written by that thread only, read by whoever holds
+ * Session::drainMutex. Counters run freely; index = count % kCapacity.
+ */
+struct ThreadBuffer {
+  static constexpr std::uint32_t kCapacity = 1 << 14;
+
+  int id = 0;
+  std::string name;
+  bool named = false; // thread_name metadata written (drain side)
+
+  std::array<Event, kCapacity> events;
+  std::atomic<std::uint32_t> numWritten{0};
+  std::atomic<std::uint32_t> numRead{0};
+  std::atomic<std::uint32_t> numDropped{0};
+  std::uint32_t numDroppedReported = 0; // drain side
+
+  void push(const Event &event) {
+    const auto written = numWritten.load(std::memory_order_relaxed);
+    if (written - numRead.load(std::memory_order_acquire) >= kCapacity) {
+      numDropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    events[written % kCapacity] = event;
+    numWritten.store(written + 1, std::memory_order_release);
+  }
+};
+
+int getProcessId() {
+#if defined(_WIN32)
+  return _getpid();
+#else
+  return int(getpid());
+#endif
+}
+
+std::string escapeJson(const std::string &text) {
+  std::string escaped;
+  for (char c : text) {
+    if (c == '"' || c == '\\')
+      escaped += '\\';
+    if (static_cast<unsigned char>(c) >= 0x20)
+      escaped += c;
+  }
+  return escaped;
+}
+
+//==============================================================================
+class Session {
+public:
+  Session() : processId(getProcessId()) {
+    writer = std::thread([this] { writerLoop(); });
+  }
+
+  ~Session() {
+    {
+      const std::lock_guard<std::mutex> lock(stopMutex);
+      stopping = true;
+    }
+    stopCondition.notify_one();
+    writer.join();
+
+    drain();
+    if (file != nullptr) {
+      std::fputs("\n]\n", file);
+      std::fclose(file);
+    }
+  }
+
+  /** Called once per thread, on its first marker. */
+  ThreadBuffer *addThread() {
+    auto buffer = std::make_unique<ThreadBuffer>();
+
+    if (juce::MessageManager::existsAndIsCurrentThread())
+      buffer->name = "Message thread";
+    else if (auto *thread = juce::Thread::getCurrentThread())
+      buffer->name = thread->getThreadName().toStdString();
+
+    const std::lock_guard<std::mutex> lock(threadsMutex);
+    buffer->id = int(threads.size()) + 1;
+    if (buffer->name.empty())
+      buffer->name = "Thread " + std::to_string(buffer->id);
+
+    threads.push_back(std::move(buffer));
+    return threads.back().get();
+  }
+
+  /** Writes every recorded event to the file. Any thread but the audio
+      thread. */
+  void drain() {
+    const std::lock_guard<std::mutex> drainLock(drainMutex);
+
+    std::vector<ThreadBuffer *> buffers;
+    {
+      const std::lock_guard<std::mutex> lock(threadsMutex);
+      for (auto &thread : threads)
+        buffers.push_back(thread.get());
+    }
+
+    for (auto *buffer : buffers)
+      drainThread(*buffer);
+
+    if (file != nullptr)
+      std::fflush(file);
+  }
+
+private:
+  const int processId;
+
+  std::mutex threadsMutex; // guards threads (registration vs. drain)
+  std::vector<std::unique_ptr<ThreadBuffer>> threads;
+
+  std::mutex drainMutex; // one reader at a time: writer thread or flush()
+  std::FILE *file = nullptr;
+  bool firstEvent = true;
+
+  std::thread writer;
+  std::mutex stopMutex;
+  std::condition_variable stopCondition;
+  bool stopping = false;
+
+  void writerLoop() {
+    std::unique_lock<std::mutex> lock(stopMutex);
+    while (!stopCondition.wait_for(lock, std::chrono::milliseconds(100),
+                                   [this] { return stopping; })) {
+      lock.unlock();
+      drain();
+      lock.lock();
+    }
+  }
+
+  bool openFile() {
+    if (file != nullptr)
+      return true;
+
+    std::string path;
+    if (const char *variable = std::getenv("VT2R_TRACE_FILE"))
+      path = variable;
+    else
+      path = (std::filesystem::temp_directory_path() /
+              ("vt2r-trace-" + std::to_string(processId) + ".json"))
+                 .string();
+
+    file = std::fopen(path.c_str(), "w");
+    if (file == nullptr)
+      return false;
+
+    std::fputs("[\n", file);
+    return true;
+  }
+
+  void writeEvent(const char *json) {
+    if (!openFile())
+      return;
+
+    if (!firstEvent)
+      std::fputs(",\n", file);
+    std::fputs(json, file);
+    firstEvent = false;
+  }
+
+  void drainThread(ThreadBuffer &buffer) {
+    const auto written = buffer.numWritten.load(std::memory_order_acquire);
+    auto read = buffer.numRead.load(std::memory_order_relaxed);
+    char json[512];
+
+    if (!buffer.named && written != read) {
+      std::snprintf(json, sizeof(json),
+                    "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,"
+                    "\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                    processId, buffer.id, escapeJson(buffer.name).c_str());
+      writeEvent(json);
+      buffer.named = true;
+    }
+
+    for (; read != written; ++read) {
+      const auto &event = buffer.events[read % ThreadBuffer::kCapacity];
+      std::snprintf(json, sizeof(json),
+                    "{\"name\":\"%s\",\"cat\":\"vt2r\",\"ph\":\"X\","
+                    "\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%d}",
+                    event.name, double(event.begin) * 1.0e-3,
+                    double(event.end - event.begin) * 1.0e-3, processId,
+                    buffer.id);
+      writeEvent(json);
+    }
+    buffer.numRead.store(read, std::memory_order_release);
+
+    // Overflow shows up as an instant event where it was noticed
+    const auto dropped = buffer.numDropped.load(std::memory_order_relaxed);
+    if (dropped != buffer.numDroppedReported) {
+      std::snprintf(json, sizeof(json),
+                    "{\"name\":\"%u events dropped (buffer full)\","
+                    "\"cat\":\"vt2r\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,"
+                    "\"pid\":%d,\"tid\":%d}",
+                    unsigned(dropped - buffer.numDroppedReported),
+                    double(VT2RTrace::now()) * 1.0e-3, processId, buffer.id);
+      writeEvent(json);
+      buffer.numDroppedReported = dropped;
+    }
+  }
+};
+
+Session &getSession() {
+  static Session session;
+  return session;
+}
+
+thread_local ThreadBuffer *threadBuffer = nullptr;
+
+} // namespace
+
+namespace VT2RTrace {
+std::int64_t now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void record(const char *name, std::int64_t begin, std::int64_t end) {
+  if (threadBuffer == nullptr)
+    threadBuffer = getSession().addThread();
+
+  threadBuffer->push({name, begin, end});
+}
+
+void flush() { getSession().drain(); }
+} // namespace VT2RTrace
+
+#endif // VT2R_TRACE
@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+    VT-2R - EMU AUDIO
+    Trace Markers
+
+    Scoped markers around processBlock, prepare, state and paint calls,
+    written as Chrome trace-event JSON (VT2R_TRACE=1 builds only).
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#ifndef VT2R_TRACE
+#define VT2R_TRACE 0
+#endif
+
+namespace VT2RTrace {
+
+//==============================================================================
+/**
+ * VT2R_TRACE_SCOPE("name") records the rest of the enclosing scope as one
+ * complete event ("ph": "X") on the calling thread. name must be a string
+ * literal (only the pointer is kept).
+ *
+ * Recording takes two clock reads and one store into the thread's own ring
+ * buffer (single producer, lock-free); a full buffer drops the event and
+ * counts it. The first marker on a thread allocates that thread's buffer
+ * once. A writer thread drains the buffers every 100 ms into the file named
+ * by the VT2R_TRACE_FILE environment variable, or
+ * <temp>/vt2r-trace-<pid>.json. The JSON array is closed at exit;
+ * Perfetto (ui.perfetto.dev) and chrome://tracing also read it unclosed, so
+ * a crash keeps everything up to the last flush.
+ *
+ * Timestamps are std::chrono::steady_clock (CLOCK_MONOTONIC,
+ * mach_absolute_time, QueryPerformanceCounter) in microseconds, so the
+ * markers line up with host traces taken on the same clock.
+ *
+ * Without VT2R_TRACE the macro expands to nothing and TraceMarkers.cpp is
+ * empty. CMake sets it for -DVT2R_TRACE=ON in every configuration except
+ * Release.
+ */
+constexpr bool kEnabled = VT2R_TRACE != 0;
+
+#if VT2R_TRACE
+/** steady_clock time in nanoseconds. */
+std::int64_t now();
+
+/** One complete event on the calling thread (begin / end from now()). */
+void record(const char *name, std::int64_t begin, std::int64_t end);
+
+/** Writes every event recorded so far (tools, before reading the file). */
+void flush();
+
+class Scope {
+public:
+  explicit Scope(const char *markerName) : name(markerName), begin(now()) {}
+  ~Scope() { record(name, begin, now()); }
+
+  Scope(const Scope &) = delete;
+  Scope &operator=(const Scope &) = delete;
+
+private:
+  const char *name;
+  std::int64_t begin;
+};
+
+#define VT2R_TRACE_CONCAT_(a, b) a##b
+#define VT2R_TRACE_CONCAT(a, b) VT2R_TRACE_CONCAT_(a, b)
+#define VT2R_TRACE_SCOPE(name)                                                 \
+  const VT2RTrace::Scope VT2R_TRACE_CONCAT(vt2rTraceScope, __LINE__)(name)
+#else
+inline void flush() {}
+
+#define VT2R_TRACE_SCOPE(name) static_cast<void>(0)
+#endif
+
+} // namespace VT2RTrace
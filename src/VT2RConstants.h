@@ -0,0 +1,79 @@
+/*
+  ==============================================================================
+    VT-2R - EMU AUDIO
+    Shared DSP constants
+  ==============================================================================
+*/
+
+#pragma once
+
+//==============================================================================
+// Constants for VT-2R
+namespace VT2RConstants {
+// Drive Range
+constexpr float kDriveMin = 0.0f;
+constexpr float kDriveMax = 100.0f; // User sees 0-100
+constexpr float kDriveDefault = 0.0f;
+constexpr float kDriveInterval = 0.1f; // Parameter step
+
+// Mix Range
+constexpr float kMixMin = 0.0f;
+constexpr float kMixMax = 100.0f;
+constexpr float kMixDefault = 100.0f;
+
+// Saturator Quality (0 = Eco, 1 = Normal, 2 = Precise)
+constexpr int kQualityDefault = 2;
+
+// Oversampling (0 = Off, 1 = 2x, 2 = 4x, 3 = 8x)
+constexpr int kOversamplingDefault = 1;
+
+// Saturator anti-aliasing (0 = Off, 1 = ADAA 1st order)
+constexpr int kAntialiasingDefault = 0;
+
+// Wet path character (0 = Aggressive, 1 = Glue)
+constexpr int kCharacterDefault = 0;
+
+// DSP Constants
+constexpr float kPreEmphasisFreq = 2000.0f; // 2kHz
+constexpr float kPreEmphasisQ = 0.7f;
+constexpr float kMaxPreEmphasisGainDb = 9.0f; // Boost mids up to 9dB
+
+// Glue character stages (GlueChain.h). Amounts are the values at Drive 100
+// and scale linearly with Drive, so Drive 0 leaves only the allpass.
+constexpr float kTapeDensityMax = 0.3f;       // k of x / (1 + k x^2)
+constexpr float kSecondHarmonicMax = 0.05f;   // y^2 on the saturator output
+constexpr float kThirdHarmonicMax = 0.02f;    // y^3
+constexpr float kHarmonicDcBlockFreq = 10.0f; // DC blocker on the y^2 term
+constexpr float kTransientAmountMax = 0.15f;  // peak reduction at full knee
+constexpr float kTransientThreshold = 0.5f;   // envelope, saturator scale
+constexpr float kTransientKnee = 0.4f;
+constexpr float kTransientReleaseMs = 50.0f;
+constexpr float kPhaseStabiliserFreq = 80.0f; // 1st order allpass
+
+// Control slice length: per-sample control values are prepared slice by slice
+// and pre-emphasis coefficients are refreshed at most once per slice.
+constexpr int kCoefficientUpdateInterval = 16;
+
+// Sub-block length (base-rate samples): every host buffer is processed in
+// sub-blocks on a fixed grid that carries over from one buffer to the next,
+// with the control-rate work (parameters, Drive/Mix decisions, ramps) once
+// per sub-block. A multiple of kCoefficientUpdateInterval.
+constexpr int kSubBlockSize = 64;
+static_assert(kSubBlockSize % kCoefficientUpdateInterval == 0,
+              "control slices must tile a sub-block");
+
+// Offline rendering: sub-blocks per chunk. The control of a whole chunk is
+// worked out first, then each lane group runs through all of its
+// sub-blocks, so the workers get enough to do per wake-up.
+constexpr int kOfflineChunkSubBlocks = 16;
+
+// Offline rendering: chunks shorter than this (base-rate samples) keep their
+// lane groups on the calling thread - waking the workers would cost more
+// than it saves.
+constexpr int kMinParallelChunkSize = 256;
+
+// Input below this (-120 dBFS) counts as silence; after the tail has
+// decayed the processor idles until signal returns.
+constexpr float kSilenceThreshold = 1.0e-6f;
+
+} // namespace VT2RConstants
@@ -0,0 +1,173 @@
+/*
+  ==============================================================================
+    VT-2R - EMU AUDIO
+    Worker Pool
+
+    Threads that share one caller's independent tasks (offline rendering).
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace VT2RDSP {
+
+//==============================================================================
+/**
+ * A fixed set of worker threads that run(numTasks, task) spreads task(0) ...
+ * task(numTasks - 1) over, the calling thread included. run() returns once
+ * every task is done.
+ *
+ * Which thread runs which task is not fixed, so tasks must not share
+ * mutable state; the result is then exactly that of a serial loop. Waking
+ * the workers costs a few microseconds and run() blocks, so this is for
+ * non-realtime processing (bounces, freezes) only - never on a realtime
+ * audio thread. run() itself does not allocate.
+ *
+ * Any number of threads may call run(). The workers take one caller's job
+ * at a time; a caller that finds them busy runs its tasks itself, serially.
+ * The cores are busy with the other job then, so it neither waits for that
+ * job nor starts more threads than there are cores (getShared).
+ */
+class WorkerPool {
+public:
+  /** Starts numWorkers threads (0: run() executes on the caller alone). */
+  explicit WorkerPool(int numWorkers) {
+    for (int i = 0; i < numWorkers; ++i)
+      threads.emplace_back([this] { workerLoop(); });
+  }
+
+  ~WorkerPool() {
+    {
+      const std::lock_guard<std::mutex> lock(mutex);
+      quit = true;
+    }
+    wake.notify_all();
+
+    for (auto &thread : threads)
+      thread.join();
+  }
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool &operator=(const WorkerPool &) = delete;
+
+  /**
+   * The process-wide pool: one worker per core beyond the caller's, shared
+   * by every processor instance, so instances rendering offline side by
+   * side (or vt2r_render -j N) never oversubscribe the machine. Built by the
+   * first call and freed with its last holder (as SharedTableRegistry).
+   * Locks and may start threads: prepare code only.
+   */
+  static std::shared_ptr<WorkerPool> getShared() {
+    static std::mutex sharedMutex;
+    static std::weak_ptr<WorkerPool> shared;
+    const std::lock_guard<std::mutex> lock(sharedMutex);
+
+    auto pool = shared.lock();
+    if (pool == nullptr) {
+      const int numCores = int(std::thread::hardware_concurrency());
+      pool = std::make_shared<WorkerPool>(std::max(numCores - 1, 0));
+      shared = pool;
+    }
+    return pool;
+  }
+
+  int getNumWorkers() const { return int(threads.size()); }
+
+  template <typename Task> void run(int numTasks, Task &&task) {
+    std::unique_lock<std::mutex> caller(callerMutex, std::try_to_lock);
+
+    if (threads.empty() || numTasks <= 1 || !caller.owns_lock()) {
+      for (int i = 0; i < numTasks; ++i)
+        task(i);
+      return;
+    }
+
+    {
+      const std::lock_guard<std::mutex> lock(mutex);
+      job = {&invoke<std::remove_reference_t<Task>>,
+             const_cast<void *>(static_cast<const void *>(&task)), numTasks};
+      nextTask.store(0, std::memory_order_relaxed);
+      ++generation;
+    }
+
+    // Only as many workers as there are tasks besides the caller's
+    const int numToWake = std::min(numTasks - 1, getNumWorkers());
+    for (int i = 0; i < numToWake; ++i)
+      wake.notify_one();
+
+    runTasks(job);
+
+    // Workers that joined this job have all left it, so none can pick up a
+    // stale task once the next run() resets nextTask
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this] { return numBusy == 0; });
+    job = {};
+  }
+
+private:
+  struct Job {
+    void (*call)(void *, int) = nullptr;
+    void *context = nullptr;
+    int numTasks = 0;
+  };
+
+  std::vector<std::thread> threads;
+
+  std::mutex callerMutex; // held by the caller whose job the workers run
+  std::mutex mutex;
+  std::condition_variable wake, done;
+  Job job;                       // guarded by mutex
+  unsigned generation = 0;       // run() count, guarded by mutex
+  int numBusy = 0;               // workers inside runTasks, guarded by mutex
+  bool quit = false;             // guarded by mutex
+  std::atomic<int> nextTask{0};
+
+  template <typename Task> static void invoke(void *context, int index) {
+    (*static_cast<Task *>(context))(index);
+  }
+
+  void runTasks(const Job &current) {
+    for (;;) {
+      const int index = nextTask.fetch_add(1, std::memory_order_relaxed);
+      if (index >= current.numTasks)
+        return;
+      current.call(current.context, index);
+    }
+  }
+
+  void workerLoop() {
+    unsigned seen = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+
+    for (;;) {
+      wake.wait(lock, [&] { return quit || generation != seen; });
+      if (quit)
+        return;
+
+      seen = generation;
+      if (job.call == nullptr)
+        continue; // that run() has already finished
+
+      const Job current = job;
+      ++numBusy;
+      lock.unlock();
+
+      runTasks(current);
+
+      lock.lock();
+      if (--numBusy == 0)
+        done.notify_one();
+    }
+  }
+};
+
+} // namespace VT2RDSP
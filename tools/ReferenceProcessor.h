@@ -0,0 +1,140 @@
+/*
+  ==============================================================================
+    VT-2R - EMU AUDIO
+    Reference Processor (frozen)
+
+    The original per-sample scalar signal chain, kept unchanged as the
+    reference that vt2r_compare nulls the optimized processBlock against.
+    Do not optimize this file: its whole job is to stay the sound that was
+    signed off.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "VT2RConstants.h"
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include <cmath>
+#include <vector>
+
+namespace VT2RTools {
+
+//==============================================================================
+/**
+ * Per sample, per channel: Pre-Emphasis (RBJ peaking biquad, coefficients
+ * recomputed from the smoothed Drive every sample) -> std::tanh saturation
+ * -> makeup gain -> Mix. Drive and Mix are smoothed with 20 ms linear
+ * ramps. No oversampling, no latency.
+ */
+class ReferenceProcessor {
+public:
+  /** Starts at drive / mix (0-100) without ramping, like prepareToPlay. */
+  void prepare(double newSampleRate, int numChannels, float drive,
+               float mixPercent) {
+    sampleRate = newSampleRate;
+    states.assign(size_t(numChannels), FilterState());
+
+    smoothedDrive.reset(sampleRate, 0.02);
+    smoothedMix.reset(sampleRate, 0.02);
+    smoothedDrive.setCurrentAndTargetValue(drive);
+    smoothedMix.setCurrentAndTargetValue(mixPercent / 100.0f);
+  }
+
+  /** New targets (0-100), taken at the start of the next block. */
+  void setTargets(float drive, float mixPercent) {
+    smoothedDrive.setTargetValue(drive);
+    smoothedMix.setTargetValue(mixPercent / 100.0f);
+  }
+
+  void process(float *const *channels, int numChannels, int numSamples) {
+    juce::ScopedNoDenormals noDenormals;
+
+    for (int sample = 0; sample < numSamples; ++sample) {
+      const float currentDrive = smoothedDrive.getNextValue();
+      const float currentMix = smoothedMix.getNextValue();
+
+      for (int ch = 0; ch < numChannels; ++ch) {
+        const float dry = channels[ch][sample];
+
+        // 1. Input Gain & Pre-Emphasis
+        float wet = processPreEmphasis(dry, currentDrive, states[size_t(ch)]);
+
+        // 2. Saturation
+        wet = processSaturation(wet, currentDrive);
+
+        // 3. Output makeup
+        wet *= calculateMakeupGain(currentDrive);
+
+        channels[ch][sample] = dry * (1.0f - currentMix) + wet * currentMix;
+      }
+    }
+  }
+
+private:
+  struct FilterState {
+    float z1 = 0.0f;
+    float z2 = 0.0f;
+  };
+
+  float processPreEmphasis(float input, float drive, FilterState &state) const {
+    // Drive 0-100 -> Gain 0dB to +9dB
+    float normDrive = drive / 100.0f;
+    float gainDb = normDrive * VT2RConstants::kMaxPreEmphasisGainDb;
+
+    double A = std::pow(10.0, gainDb / 40.0);
+    double w0 = 2.0 * juce::MathConstants<double>::pi *
+                VT2RConstants::kPreEmphasisFreq / sampleRate;
+    double alpha = std::sin(w0) / (2.0 * VT2RConstants::kPreEmphasisQ);
+
+    double b0 = 1.0 + alpha * A;
+    double b1 = -2.0 * std::cos(w0);
+    double b2 = 1.0 - alpha * A;
+    double a0 = 1.0 + alpha / A;
+    double a1 = -2.0 * std::cos(w0);
+    double a2 = 1.0 - alpha / A;
+
+    // Normalize by a0
+    float fb0 = float(b0 / a0);
+    float fb1 = float(b1 / a0);
+    float fb2 = float(b2 / a0);
+    float fa1 = float(a1 / a0);
+    float fa2 = float(a2 / a0);
+
+    // DF2
+    float w = input - fa1 * state.z1 - fa2 * state.z2;
+    float output = fb0 * w + fb1 * state.z1 + fb2 * state.z2;
+
+    // Denormal protection
+    if (std::abs(w) < 1e-20f)
+      w = 0.0f;
+
+    state.z2 = state.z1;
+    state.z1 = w;
+
+    return output;
+  }
+
+  static float processSaturation(float input, float drive) {
+    float normDrive = drive / 100.0f;
+
+    // Input Gain boost: Up to +18dB driving the saturator
+    float inputGain = 1.0f + normDrive * 8.0f;
+
+    return std::tanh(input * inputGain);
+  }
+
+  static float calculateMakeupGain(float drive) {
+    float normDrive = drive / 100.0f;
+    return 1.0f / (1.0f + normDrive * 4.0f);
+  }
+
+  double sampleRate = 44100.0;
+  std::vector<FilterState> states;
+
+  juce::SmoothedValue<float> smoothedDrive;
+  juce::SmoothedValue<float> smoothedMix;
+};
+
+} // namespace VT2RTools
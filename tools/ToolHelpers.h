@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+    VT-2R - EMU AUDIO
+    Console Tool Helpers
+
+    Parameter and command line plumbing shared by the tools in tools/.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "PluginProcessor.h"
+
+namespace VT2RTools {
+
+//==============================================================================
+/** Sets a plugin parameter in its real units, the way a host would. */
+inline void setParameterValue(VT2BBlackProcessor &processor,
+                              const juce::String &id, float value) {
+  if (auto *parameter = processor.getParameters().getParameter(id))
+    parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+}
+
+/** Case-insensitive lookup of value in names; false if not found. */
+inline bool parseChoice(const juce::String &value,
+                        const juce::StringArray &names, int &index) {
+  index = names.indexOf(value.trim(), true);
+  return index >= 0;
+}
+
+/**
+ * Puts the processor into the usual layout for numChannels (mono, stereo,
+ * 5.1, 7.1, 7.1.4 ...); other counts fall back to discrete channels.
+ */
+inline juce::AudioChannelSet channelSetFor(int numChannels) {
+  if (numChannels == 12)
+    return juce::AudioChannelSet::create7point1point4();
+
+  auto channelSet = juce::AudioChannelSet::canonicalChannelSet(numChannels);
+  if (channelSet.isDisabled())
+    channelSet = juce::AudioChannelSet::discreteChannels(numChannels);
+  return channelSet;
+}
+
+inline bool setChannelLayout(VT2BBlackProcessor &processor, int numInputs,
+                             int numOutputs) {
+  juce::AudioProcessor::BusesLayout layout;
+  layout.inputBuses.add(channelSetFor(numInputs));
+  layout.outputBuses.add(channelSetFor(numOutputs));
+  return processor.setBusesLayout(layout);
+}
+
+inline bool setChannelLayout(VT2BBlackProcessor &processor, int numChannels) {
+  return setChannelLayout(processor, numChannels, numChannels);
+}
+
+//==============================================================================
+/**
+ * --quality / --oversampling / --filter / --antialiasing / --character,
+ * applied as plugin parameters.
+ * Unset options (-1) keep the plugin defaults.
+ */
+struct ProcessingOptions {
+  int quality = -1;
+  int oversampling = -1;
+  int oversamplingFilter = -1;
+  int antialiasing = -1;
+  int character = -1;
+
+  static constexpr const char *kUsage =
+      "  --quality <q>           eco | normal | precise\n"
+      "  --oversampling <os>     off | 2x | 4x | 8x\n"
+      "  --filter <f>            min | linear\n"
+      "  --antialiasing <aa>     off | adaa1\n"
+      "  --character <c>         aggressive | glue\n";
+
+  /** Consumes the options from args; returns false with error set. */
+  bool parse(juce::ArgumentList &args, juce::String &error) {
+    if (args.containsOption("--quality") &&
+        !parseChoice(args.removeValueForOption("--quality"),
+                     {"eco", "normal", "precise"}, quality)) {
+      error = "--quality must be eco, normal or precise";
+      return false;
+    }
+
+    if (args.containsOption("--oversampling") &&
+        !parseChoice(args.removeValueForOption("--oversampling"),
+                     {"off", "2x", "4x", "8x"}, oversampling)) {
+      error = "--oversampling must be off, 2x, 4x or 8x";
+      return false;
+    }
+
+    if (args.containsOption("--filter") &&
+        !parseChoice(args.removeValueForOption("--filter"), {"min", "linear"},
+                     oversamplingFilter)) {
+      error = "--filter must be min or linear";
+      return false;
+    }
+
+    if (args.containsOption("--antialiasing") &&
+        !parseChoice(args.removeValueForOption("--antialiasing"),
+                     {"off", "adaa1"}, antialiasing)) {
+      error = "--antialiasing must be off or adaa1";
+      return false;
+    }
+
+    if (args.containsOption("--character") &&
+        !parseChoice(args.removeValueForOption("--character"),
+                     {"aggressive", "glue"}, character)) {
+      error = "--character must be aggressive or glue";
+      return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * Call before prepareToPlay (oversampling / ADAA / character changes
+   * re-prepare).
+   */
+  void apply(VT2BBlackProcessor &processor) const {
+    if (quality >= 0)
+      setParameterValue(processor, "quality", float(quality));
+    if (oversampling >= 0)
+      setParameterValue(processor, "oversampling", float(oversampling));
+    if (oversamplingFilter >= 0)
+      setParameterValue(processor, "oversamplingFilter",
+                        float(oversamplingFilter));
+    if (antialiasing >= 0)
+      setParameterValue(processor, "antialiasing", float(antialiasing));
+    if (character >= 0)
+      setParameterValue(processor, "character", float(character));
+  }
+};
+
+} // namespace VT2RTools
@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+    VT-2R - EMU AUDIO
+    vt2r_bake_images - Build-time Image Conversion
+
+    Decodes a PNG from resources/ and writes its bakes (decoded,
+    premultiplied, resampled to each display scale, zlib compressed) into
+    one file for the editor's binary data. Run by the build, see
+    VT2R_IMAGE_SCALES in CMakeLists.txt.
+  ==============================================================================
+*/
+
+#include "BakedImage.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+const char *const kUsage =
+    "Usage: vt2r_bake_images <input.png> <output> <logical width> "
+    "<scale>...\n"
+    "\n"
+    "  logical width  Width the editor draws the image at (component units)\n"
+    "  scale          Display scales to bake for (1, 1.5, 2 ...)\n"
+    "\n"
+    "Scales beyond the PNG's own resolution share one bake at that\n"
+    "resolution; the editor scales it up when drawing.\n";
+
+} // namespace
+
+//==============================================================================
+int main(int argc, char *argv[]) {
+  juce::ArgumentList args(argc, argv);
+
+  auto fail = [](const juce::String &message) {
+    std::fprintf(stderr, "vt2r_bake_images: %s\n", message.toRawUTF8());
+    return 1;
+  };
+
+  if (args.containsOption("-h|--help")) {
+    std::fputs(kUsage, stdout);
+    return 0;
+  }
+
+  if (args.size() < 4) {
+    std::fputs(kUsage, stderr);
+    return 1;
+  }
+
+  const auto input = args[0].resolveAsFile();
+  const auto output = args[1].resolveAsFile();
+  const int logicalWidth = args[2].text.getIntValue();
+
+  std::vector<float> scales;
+  for (int i = 3; i < args.size(); ++i)
+    scales.push_back(args[i].text.getFloatValue());
+  std::sort(scales.begin(), scales.end());
+
+  if (logicalWidth <= 0 || scales.front() <= 0.0f)
+    return fail("logical width and scales must be positive");
+
+  const auto source = juce::ImageFileFormat::loadFrom(input);
+  if (!source.isValid())
+    return fail("cannot decode " + input.getFullPathName());
+
+  // Upscaling at build time would only store interpolated pixels
+  const float sourceScale = float(source.getWidth()) / float(logicalWidth);
+
+  juce::MemoryBlock bakes;
+  int bakedWidth = 0;
+  for (float scale : scales) {
+    scale = juce::jmin(scale, sourceScale);
+    const int width = juce::roundToInt(float(logicalWidth) * scale);
+    if (width == bakedWidth)
+      continue; // capped: same bake as the previous scale
+
+    const auto baked = VT2RAssets::bake(source, logicalWidth, scale);
+    bakes.append(baked.getData(), baked.getSize());
+    bakedWidth = width;
+  }
+
+  if (!output.getParentDirectory().createDirectory() ||
+      !output.replaceWithData(bakes.getData(), bakes.getSize()))
+    return fail("cannot write " + output.getFullPathName());
+
+  return 0;
+}
@@ -0,0 +1,952 @@
+/*
+  ==============================================================================
+    VT-2R - EMU AUDIO
+    vt2r_bench - Microbenchmarks
+
+    processBlock swept over block size x sample rate x layout x automation,
+    the bypass states (Drive 0, Mix 0, silence), the shipping lane kernels,
+    aliasing versus CPU of the anti-aliasing options, the setup cost of
+    further instances, session save / recall and opening the editor. Results
+    go to the console and, optionally, JSON/CSV for comparing commits.
+  ==============================================================================
+*/
+
+#include "PluginProcessor.h"
+#include "ToolHelpers.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr double kSampleRates[] = {44100.0, 48000.0,  88200.0,
+                                   96000.0, 176400.0, 192000.0};
+constexpr int kMaxBlockSize = 8192;
+constexpr int kSourceLength = kMaxBlockSize; // looped test signal
+constexpr int kStagePassLength = 4096;
+constexpr double kStageSampleRate = 48000.0;
+constexpr int kStateBlockSize = 512; // bypass states and offline cases
+constexpr float kSteadyDrive = 50.0f;
+constexpr float kSteadyMix = 100.0f;
+
+// Aliasing cases: stereo, 48 kHz, Drive 100, a -6 dBFS sine near 5 kHz
+constexpr int kAliasingLength = 65536; // analysis window, a power of two
+constexpr double kAliasingFrequency = 5000.0;
+constexpr float kAliasingDrive = 100.0f;
+
+// Instance cases: construct + prepareToPlay, stereo, 48 kHz
+constexpr int kNumInstances = 100;
+
+// State cases: one call per instance of a 200-instance session, repeated
+constexpr int kStateCalls = 200;
+
+// Editor cases: opens per display scale (the first one loads the images)
+constexpr int kEditorOpens = 20;
+
+const char *const kUsage =
+    "Usage: vt2r_bench [options]\n"
+    "\n"
+    "  --quick                 Reduced sweep (4 block sizes, 3 rates)\n"
+    "  --only <part>           sweep | stages | aliasing | instances | state\n"
+    "                          | editor\n"
+    "  --runs <n>              Timed runs per case (default: 5)\n"
+    "  --seconds <s>           Audio per run (default: 0.25)\n"
+    "  --label <text>          Stored with the results (e.g. commit id)\n"
+    "  --json <file>           Write results as JSON\n"
+    "  --csv <file>            Write results as CSV\n";
+
+//==============================================================================
+struct BenchSettings {
+  int runs = 5;
+  double secondsPerRun = 0.25;
+  bool quick = false;
+  bool runSweep = true;
+  bool runStages = true;
+  bool runAliasing = true;
+  bool runInstances = true;
+  bool runState = true;
+  bool runEditor = true;
+  juce::String label;
+  VT2RTools::ProcessingOptions processing;
+};
+
+/** Timing of one case; ns are per sample frame (all channels). */
+struct BenchResult {
+  juce::String group; // processBlock, stage, aliasing, instances, state,
+                      // editor
+  juce::String name;
+  double sampleRate = 0.0;
+  int blockSize = 0;
+  int numChannels = 0;
+  juce::String automation;
+  double nsMean = 0.0;
+  double nsVariance = 0.0;
+  double nsMin = 0.0;
+
+  // "aliasing" only: folded-back power relative to the fundamental, and the
+  // fundamental's level (shows ADAA's high-frequency droop)
+  double aliasingDb = 0.0;
+  double fundamentalDb = 0.0;
+
+  // "instances": construct + prepareToPlay per instance, and the
+  // pre-emphasis tables alive afterwards (one per rate when shared)
+  double setupMs = 0.0;
+  int numTables = 0;
+
+  // "editor": open + first paint + close per editor, in setupMs
+
+  // "state" only: one get/setStateInformation call, and the blob size
+  double usPerCall = 0.0;
+  int stateBytes = 0;
+
+  double nsStdDev() const { return std::sqrt(nsVariance); }
+
+  /** Seconds of audio processed per second of CPU time. */
+  double realtimeFactor() const {
+    return nsMean > 0.0 ? 1.0e9 / (nsMean * sampleRate) : 0.0;
+  }
+};
+
+//==============================================================================
+/**
+ * Runs runOnce (which processes framesPerRun frames) once untimed as a
+ * warm-up, then runs times, and stores mean/variance/min of ns per frame.
+ */
+template <typename RunOnce>
+void measure(BenchResult &result, int runs, juce::int64 framesPerRun,
+             RunOnce &&runOnce) {
+  runOnce();
+
+  std::vector<double> nsPerFrame;
+  for (int run = 0; run < runs; ++run) {
+    const auto start = juce::Time::getHighResolutionTicks();
+    runOnce();
+    const auto end = juce::Time::getHighResolutionTicks();
+
+    nsPerFrame.push_back(
+        juce::Time::highResolutionTicksToSeconds(end - start) * 1.0e9 /
+        double(framesPerRun));
+  }
+
+  double sum = 0.0;
+  for (auto ns : nsPerFrame)
+    sum += ns;
+  result.nsMean = sum / double(runs);
+
+  double squares = 0.0;
+  for (auto ns : nsPerFrame)
+    squares += (ns - result.nsMean) * (ns - result.nsMean);
+  result.nsVariance = runs > 1 ? squares / double(runs - 1) : 0.0;
+
+  result.nsMin = *std::min_element(nsPerFrame.begin(), nsPerFrame.end());
+}
+
+/** Deterministic noise at -6 dBFS. */
+juce::AudioBuffer<float> makeTestSignal(int numChannels) {
+  juce::AudioBuffer<float> signal(numChannels, kSourceLength);
+  juce::Random random(0x5652);
+
+  for (int ch = 0; ch < numChannels; ++ch)
+    for (int i = 0; i < kSourceLength; ++i)
+      signal.setSample(ch, i, (random.nextFloat() * 2.0f - 1.0f) * 0.5f);
+
+  return signal;
+}
+
+/** Input / output channel counts of a sweep layout. */
+struct SweepLayout {
+  int numInputs;
+  int numOutputs;
+};
+
+/** Sweep layouts: mono, mono -> stereo, stereo, 5.1 and a 7.1.4 bed. */
+constexpr SweepLayout kLayouts[] = {{1, 1}, {1, 2}, {2, 2}, {6, 6}, {12, 12}};
+constexpr int kMaxChannels = 12;
+
+juce::String layoutName(const SweepLayout &layout) {
+  if (layout.numInputs == 1 && layout.numOutputs == 2)
+    return "mono>stereo";
+
+  switch (layout.numOutputs) {
+  case 1:
+    return "mono";
+  case 2:
+    return "stereo";
+  case 6:
+    return "5.1";
+  case 12:
+    return "7.1.4";
+  default:
+    return juce::String(layout.numOutputs) + "ch";
+  }
+}
+
+/** Parameter/input condition of a processBlock case. */
+enum class Scenario {
+  Steady,    // fixed Drive/Mix
+  Automated, // Drive and Mix moving every block
+  DriveZero, // Drive 0: saturator only
+  MixZero,   // Mix 0: wet path skipped
+  Silent,    // silent input: engine idles after the tail
+  Offline    // fixed Drive/Mix, non-realtime: lane groups on worker threads
+};
+
+const char *scenarioName(Scenario scenario) {
+  switch (scenario) {
+  case Scenario::Steady:
+    return "steady";
+  case Scenario::Automated:
+    return "automated";
+  case Scenario::DriveZero:
+    return "drive0";
+  case Scenario::MixZero:
+    return "mix0";
+  case Scenario::Offline:
+    return "offline";
+  case Scenario::Silent:
+  default:
+    return "silent";
+  }
+}
+
+juce::int64 framesPerRun(const BenchSettings &settings, double sampleRate,
+                         int blockSize) {
+  const auto frames = juce::int64(std::ceil(settings.secondsPerRun *
+                                            sampleRate / double(blockSize)));
+  return juce::jmax<juce::int64>(frames, 1) * blockSize;
+}
+
+//==============================================================================
+/**
+ * processBlock at one sweep point. Scenario::Automated moves Drive and Mix
+ * every block (slow sines, as host automation would), so the smoothers and
+ * the coefficient interpolation stay active for the whole run.
+ */
+BenchResult benchProcessBlock(VT2BBlackProcessor &processor,
+                              const BenchSettings &settings,
+                              const juce::AudioBuffer<float> &source,
+                              double sampleRate, int blockSize,
+                              const SweepLayout &layout, Scenario scenario) {
+  BenchResult result;
+  result.group = "processBlock";
+  result.name = layoutName(layout);
+  result.sampleRate = sampleRate;
+  result.blockSize = blockSize;
+  result.numChannels = layout.numOutputs;
+  result.automation = scenarioName(scenario);
+
+  VT2RTools::setChannelLayout(processor, layout.numInputs, layout.numOutputs);
+  settings.processing.apply(processor);
+  VT2RTools::setParameterValue(
+      processor, "drive", scenario == Scenario::DriveZero ? 0.0f : kSteadyDrive);
+  VT2RTools::setParameterValue(
+      processor, "mix", scenario == Scenario::MixZero ? 0.0f : kSteadyMix);
+
+  processor.setNonRealtime(scenario == Scenario::Offline);
+  processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+  processor.prepareToPlay(sampleRate, blockSize);
+
+  const auto frames = framesPerRun(settings, sampleRate, blockSize);
+  juce::AudioBuffer<float> buffer(layout.numOutputs, blockSize);
+  juce::MidiBuffer midi;
+  juce::int64 position = 0;
+
+  measure(result, settings.runs, frames, [&] {
+    for (juce::int64 done = 0; done < frames; done += blockSize) {
+      if (scenario == Scenario::Automated) {
+        const double t = double(position) / sampleRate;
+        VT2RTools::setParameterValue(
+            processor, "drive",
+            float(50.0 + 50.0 * std::sin(juce::MathConstants<double>::twoPi *
+                                         0.5 * t)));
+        VT2RTools::setParameterValue(
+            processor, "mix",
+            float(50.0 + 50.0 * std::sin(juce::MathConstants<double>::twoPi *
+                                         0.3 * t)));
+      }
+
+      const int offset = int(position % kSourceLength);
+      if (scenario == Scenario::Silent)
+        buffer.clear();
+      else
+        for (int ch = 0; ch < layout.numInputs; ++ch)
+          buffer.copyFrom(ch, 0, source, ch, offset, blockSize);
+
+      processor.processBlock(buffer, midi);
+      position += blockSize;
+    }
+  });
+
+  processor.releaseResources();
+  processor.setNonRealtime(false);
+  return result;
+}
+
+//==============================================================================
+/** Stage timings at 48 kHz over kStagePassLength-sample passes. */
+std::vector<BenchResult> benchStages(const BenchSettings &settings,
+                                     const juce::AudioBuffer<float> &source) {
+  std::vector<BenchResult> results;
+
+  const auto frames =
+      framesPerRun(settings, kStageSampleRate, kStagePassLength);
+  const auto coeffs =
+      VT2RDSP::PreEmphasisTable<float>::compute(kSteadyDrive, kStageSampleRate);
+
+  std::vector<float> output(static_cast<size_t>(kStagePassLength));
+  volatile float sink = 0.0f; // keeps the results observable
+
+  auto addStage = [&](const juce::String &name, int numChannels,
+                      auto &&processPass) {
+    BenchResult result;
+    result.group = "stage";
+    result.name = name;
+    result.sampleRate = kStageSampleRate;
+    result.blockSize = kStagePassLength;
+    result.numChannels = numChannels;
+    result.automation = "steady";
+
+    measure(result, settings.runs, frames, [&] {
+      for (juce::int64 done = 0; done < frames; done += kStagePassLength) {
+        processPass();
+        sink = sink + output[size_t(kStagePassLength - 1)];
+      }
+    });
+
+    results.push_back(result);
+  };
+
+  // --- Wet lane kernel per saturator tier (one lane group, no OS) ---
+  constexpr int kLaneChannels = VT2RDSP::SIMDVector::kNumLanes;
+  std::vector<VT2RDSP::SIMDVector> lanes(static_cast<size_t>(kStagePassLength));
+  float lastFrame[kLaneChannels];
+  constexpr int kSlice = VT2RConstants::kCoefficientUpdateInterval;
+  float inputGain[kSlice], makeupGain[kSlice], normDrive[kSlice];
+  std::fill(std::begin(inputGain), std::end(inputGain), 5.0f);
+  std::fill(std::begin(makeupGain), std::end(makeupGain), 0.33f);
+  std::fill(std::begin(normDrive), std::end(normDrive), 0.5f);
+  const VT2RDSP::ControlSlice<float> control{inputGain, makeupGain,
+                                             normDrive};
+  VT2RDSP::LaneFilterState<float> laneState;
+  VT2RDSP::GlueCoefficients<float> glueCoeffs;
+  glueCoeffs.prepare(kStageSampleRate);
+  VT2RDSP::GlueLaneState<float> glueState;
+
+  auto addLaneStage = [&](const juce::String &name, auto stages,
+                          const auto &saturator) {
+    using Stages = decltype(stages);
+    addStage("processWetLanes/" + name, kLaneChannels, [&] {
+      VT2RDSP::interleaveLanes(source.getArrayOfReadPointers(), 0,
+                               kLaneChannels, kStagePassLength, lanes.data());
+
+      for (int start = 0; start < kStagePassLength; start += kSlice)
+        VT2RDSP::processWetLanes<Stages>(lanes.data() + start, kSlice, 1,
+                                         coeffs, glueCoeffs, control,
+                                         laneState, glueState, saturator);
+
+      lanes[size_t(kStagePassLength - 1)].store(lastFrame);
+      output[size_t(kStagePassLength - 1)] = lastFrame[0];
+    });
+  };
+
+  const VT2RDSP::AggressiveStages aggressive;
+  addLaneStage("Eco", aggressive, VT2RDSP::TanhRational());
+  addLaneStage("Normal", aggressive, VT2RDSP::TanhTable());
+  addLaneStage("Precise", aggressive, VT2RDSP::TanhPolynomial());
+  addLaneStage("std::tanh", aggressive, VT2RDSP::TanhReference());
+
+  VT2RDSP::ADAA1State<float> adaa1State;
+  addLaneStage("ADAA1", aggressive, VT2RDSP::TanhADAA1<float>{adaa1State});
+
+  // Glue character: every DSP_DESIGN stage fused into the same pass
+  addLaneStage("Glue+Precise", VT2RDSP::GlueCharacterStages(),
+               VT2RDSP::TanhPolynomial());
+
+  // Mono at a settled Drive: the channel in lane 0 of one vector per
+  // sample, against consecutive samples across the lanes (block biquad)
+  VT2RDSP::PreEmphasisTable<float> table;
+  table.prepare(kStageSampleRate);
+  const auto &blockMatrices = table.lookupBlock(kSteadyDrive);
+
+  auto addMonoStage = [&](const juce::String &name, bool timeLanes) {
+    addStage(name, 1, [&] {
+      VT2RDSP::interleaveLanes<1>(source.getArrayOfReadPointers(), 0, 1,
+                                  kStagePassLength, lanes.data());
+
+      if (timeLanes)
+        VT2RDSP::processMonoLanesConstant(
+            lanes.data(), kStagePassLength, coeffs, blockMatrices, glueCoeffs,
+            5.0f, 0.33f, 0.5f, laneState, glueState,
+            VT2RDSP::TanhPolynomial());
+      else
+        VT2RDSP::processWetLanesConstant<VT2RDSP::AggressiveStages>(
+            lanes.data(), kStagePassLength, coeffs, glueCoeffs, 5.0f, 0.33f,
+            0.5f, laneState, glueState, VT2RDSP::TanhPolynomial());
+
+      output[size_t(kStagePassLength - 1)] =
+          lanes[size_t(kStagePassLength - 1)].firstLane();
+    });
+  };
+
+  addMonoStage("processWetLanesConstant/mono", false);
+  addMonoStage("processMonoLanesConstant", true);
+
+  return results;
+}
+
+//==============================================================================
+/** Anti-aliasing configuration of an aliasing case (parameter indices). */
+struct AliasingCase {
+  const char *name;
+  int oversampling; // 0 = Off, 1 = 2x, 2 = 4x, 3 = 8x
+  int antialiasing; // 0 = Off, 1 = ADAA 1st order
+};
+
+constexpr AliasingCase kAliasingCases[] = {
+    {"plain", 0, 0}, {"ADAA1", 0, 1}, {"2x", 1, 0},      {"4x", 2, 0},
+    {"8x", 3, 0},    {"2x+ADAA1", 1, 1}};
+
+/**
+ * Splits one period-exact window of the output into fundamental,
+ * harmonics below Nyquist (and DC) and the rest - the folded-back
+ * harmonics plus noise. The tone sits on an odd bin of a power-of-two
+ * window, so no folded harmonic lands on a harmonic bin.
+ */
+void analyseAliasing(const std::vector<float> &output, int toneBin,
+                     BenchResult &result) {
+  const auto length = juce::int64(output.size());
+
+  // Mean power of the sinusoid in bin k (exact phases: k * i mod length)
+  auto binPower = [&](juce::int64 k) {
+    double re = 0.0, im = 0.0;
+    for (juce::int64 i = 0; i < length; ++i) {
+      const double phase = juce::MathConstants<double>::twoPi *
+                           double(k * i % length) / double(length);
+      re += output[size_t(i)] * std::cos(phase);
+      im -= output[size_t(i)] * std::sin(phase);
+    }
+    const double power = (re * re + im * im) / double(length * length);
+    return k == 0 ? power : 2.0 * power;
+  };
+
+  double total = 0.0;
+  for (auto x : output)
+    total += double(x) * double(x);
+  total /= double(length);
+
+  double harmonics = binPower(0);
+  for (juce::int64 k = toneBin; 2 * k < length; k += toneBin)
+    harmonics += binPower(k);
+
+  const double fundamental = binPower(toneBin);
+  const double folded = juce::jmax(total - harmonics, 1.0e-30);
+
+  result.aliasingDb = 10.0 * std::log10(folded / fundamental);
+  result.fundamentalDb = 10.0 * std::log10(2.0 * fundamental); // peak dBFS
+}
+
+/**
+ * CPU and aliasing of each anti-aliasing option on the same hard-driven
+ * tone: processBlock is timed as in the sweep, then one window of the
+ * settled output is analysed.
+ */
+std::vector<BenchResult> benchAliasing(VT2BBlackProcessor &processor,
+                                       const BenchSettings &settings) {
+  constexpr int kNumChannels = 2;
+  const double sampleRate = kStageSampleRate;
+  const int toneBin =
+      int(kAliasingFrequency * kAliasingLength / sampleRate) | 1;
+
+  // One window holds exactly toneBin periods, so looping it is seamless
+  juce::AudioBuffer<float> tone(kNumChannels, kAliasingLength);
+  for (int i = 0; i < kAliasingLength; ++i) {
+    const double phase = juce::MathConstants<double>::twoPi *
+                         double(juce::int64(toneBin) * i % kAliasingLength) /
+                         double(kAliasingLength);
+    for (int ch = 0; ch < kNumChannels; ++ch)
+      tone.setSample(ch, i, float(0.5 * std::sin(phase)));
+  }
+
+  std::vector<BenchResult> results;
+
+  for (const auto &aliasingCase : kAliasingCases) {
+    BenchResult result;
+    result.group = "aliasing";
+    result.name = aliasingCase.name;
+    result.sampleRate = sampleRate;
+    result.blockSize = kStateBlockSize;
+    result.numChannels = kNumChannels;
+    result.automation = "steady";
+
+    VT2RTools::setChannelLayout(processor, kNumChannels);
+    settings.processing.apply(processor);
+    VT2RTools::setParameterValue(processor, "oversampling",
+                                 float(aliasingCase.oversampling));
+    VT2RTools::setParameterValue(processor, "antialiasing",
+                                 float(aliasingCase.antialiasing));
+    VT2RTools::setParameterValue(processor, "drive", kAliasingDrive);
+    VT2RTools::setParameterValue(processor, "mix", kSteadyMix);
+
+    processor.setRateAndBufferSizeDetails(sampleRate, kStateBlockSize);
+    processor.prepareToPlay(sampleRate, kStateBlockSize);
+
+    juce::AudioBuffer<float> buffer(kNumChannels, kStateBlockSize);
+    juce::MidiBuffer midi;
+    juce::int64 position = 0;
+
+    // Returns channel 0 of the processed block
+    auto processNextBlock = [&]() -> const float * {
+      for (int i = 0; i < kStateBlockSize; ++i, ++position)
+        for (int ch = 0; ch < kNumChannels; ++ch)
+          buffer.setSample(
+              ch, i, tone.getSample(ch, int(position % kAliasingLength)));
+
+      processor.processBlock(buffer, midi);
+      return buffer.getReadPointer(0);
+    };
+
+    const auto frames = framesPerRun(settings, sampleRate, kStateBlockSize);
+    measure(result, settings.runs, frames, [&] {
+      for (juce::int64 done = 0; done < frames; done += kStateBlockSize)
+        processNextBlock();
+    });
+
+    // Settled by now (every run processed at least one block)
+    std::vector<float> output;
+    output.reserve(size_t(kAliasingLength));
+    while (int(output.size()) < kAliasingLength) {
+      const float *block = processNextBlock();
+      output.insert(output.end(), block, block + kStateBlockSize);
+    }
+
+    analyseAliasing(output, toneBin, result);
+    processor.releaseResources();
+    results.push_back(result);
+  }
+
+  return results;
+}
+
+/**
+ * Setup cost of the first instance against further ones at the same rate.
+ * The first builds the shared tables (tanh LUT, pre-emphasis, halfband
+ * designs); the others should only allocate their state. All instances stay
+ * alive until the end, as in a session. Runs before any other part, so the
+ * first instance really is the first in the process.
+ */
+std::vector<BenchResult> benchInstances(const BenchSettings &settings) {
+  constexpr int kNumChannels = 2;
+  const double sampleRate = kStageSampleRate;
+
+  std::vector<std::unique_ptr<VT2BBlackProcessor>> instances;
+  std::vector<double> setupMs;
+
+  for (int i = 0; i < kNumInstances; ++i) {
+    const auto start = juce::Time::getHighResolutionTicks();
+
+    auto instance = std::make_unique<VT2BBlackProcessor>();
+    VT2RTools::setChannelLayout(*instance, kNumChannels);
+    settings.processing.apply(*instance);
+    instance->setRateAndBufferSizeDetails(sampleRate, kStateBlockSize);
+    instance->prepareToPlay(sampleRate, kStateBlockSize);
+
+    const auto end = juce::Time::getHighResolutionTicks();
+    setupMs.push_back(juce::Time::highResolutionTicksToSeconds(end - start) *
+                      1.0e3);
+    instances.push_back(std::move(instance));
+  }
+
+  const int numTables =
+      VT2RDSP::PreEmphasisTable<float>::getRegistry().getNumTables() +
+      VT2RDSP::PreEmphasisTable<double>::getRegistry().getNumTables();
+
+  auto makeResult = [&](const juce::String &name, size_t begin, size_t end) {
+    BenchResult result;
+    result.group = "instances";
+    result.name = name;
+    result.sampleRate = sampleRate;
+    result.blockSize = kStateBlockSize;
+    result.numChannels = kNumChannels;
+    result.automation = "-";
+    result.numTables = numTables;
+
+    for (size_t i = begin; i < end; ++i)
+      result.setupMs += setupMs[i];
+    result.setupMs /= double(end - begin);
+    return result;
+  };
+
+  return {makeResult("first instance", 0, 1),
+          makeResult("further instances (" + juce::String(kNumInstances - 1) +
+                         ")",
+                     1, setupMs.size())};
+}
+
+/** The XML state of earlier versions (the legacy load path's input). */
+void getFormerXmlState(VT2BBlackProcessor &processor,
+                       juce::MemoryBlock &destData) {
+  auto state = processor.getParameters().copyState();
+  std::unique_ptr<juce::XmlElement> xml(state.createXml());
+  juce::AudioProcessor::copyXmlToBinary(*xml, destData);
+}
+
+/**
+ * Session save / recall: getStateInformation and setStateInformation per
+ * call, for the binary format and for loading an XML blob of an earlier
+ * version (the XML save is the former getStateInformation, for reference).
+ * Mean of settings.runs runs of kStateCalls calls.
+ */
+std::vector<BenchResult> benchState(VT2BBlackProcessor &processor,
+                                    const BenchSettings &settings) {
+  VT2RTools::setChannelLayout(processor, 2);
+  settings.processing.apply(processor);
+  VT2RTools::setParameterValue(processor, "drive", kSteadyDrive);
+  VT2RTools::setParameterValue(processor, "mix", kSteadyMix);
+
+  juce::MemoryBlock binary, xml;
+  processor.getStateInformation(binary);
+  getFormerXmlState(processor, xml);
+
+  std::vector<BenchResult> results;
+
+  auto addCase = [&](const char *name, const juce::MemoryBlock &blob,
+                     auto &&call) {
+    BenchResult result;
+    result.group = "state";
+    result.name = name;
+    result.automation = "-";
+    result.stateBytes = int(blob.getSize());
+
+    // ns per call; measure() divides by the frame count it is given
+    measure(result, settings.runs, kStateCalls, [&] {
+      for (int i = 0; i < kStateCalls; ++i)
+        call();
+    });
+    result.usPerCall = result.nsMean * 1.0e-3;
+    results.push_back(result);
+  };
+
+  addCase("save (binary)", binary, [&] {
+    juce::MemoryBlock block;
+    processor.getStateInformation(block);
+  });
+  addCase("load (binary)", binary, [&] {
+    processor.setStateInformation(binary.getData(), int(binary.getSize()));
+  });
+  addCase("save (xml, former)", xml, [&] {
+    juce::MemoryBlock block;
+    getFormerXmlState(processor, block);
+  });
+  addCase("load (xml, legacy)", xml, [&] {
+    processor.setStateInformation(xml.getData(), int(xml.getSize()));
+  });
+
+  return results;
+}
+
+/**
+ * Opening the editor as a host does when flipping through inserts:
+ * construct, first paint (into an image, at 1x and 2x display scale, knob
+ * frames included) and destroy. The first open at a scale loads that
+ * scale's baked images; later ones find them loaded.
+ */
+std::vector<BenchResult> benchEditor(VT2BBlackProcessor &processor) {
+  std::vector<BenchResult> results;
+
+  for (float scale : {1.0f, 2.0f}) {
+    std::vector<double> openMs;
+
+    for (int i = 0; i < kEditorOpens; ++i) {
+      const auto start = juce::Time::getHighResolutionTicks();
+
+      std::unique_ptr<juce::AudioProcessorEditor> editor(
+          processor.createEditorAndMakeActive());
+      editor->createComponentSnapshot(editor->getLocalBounds(), true, scale);
+      editor.reset();
+
+      const auto end = juce::Time::getHighResolutionTicks();
+      openMs.push_back(juce::Time::highResolutionTicksToSeconds(end - start) *
+                       1.0e3);
+    }
+
+    auto makeResult = [&](const juce::String &name, size_t begin,
+                          size_t end) {
+      BenchResult result;
+      result.group = "editor";
+      result.name = name + " " + juce::String(scale, 0) + "x";
+      result.automation = "-";
+
+      for (size_t i = begin; i < end; ++i)
+        result.setupMs += openMs[i];
+      result.setupMs /= double(end - begin);
+      return result;
+    };
+
+    results.push_back(makeResult("first open", 0, 1));
+    results.push_back(makeResult("next opens", 1, openMs.size()));
+  }
+
+  return results;
+}
+
+//==============================================================================
+void printHeader() {
+  std::printf("%-13s %-28s %8s %6s %2s %-10s %11s %10s %12s\n", "group",
+              "case", "rate", "block", "ch", "automation", "ns/sample",
+              "stddev", "x realtime");
+}
+
+void printResult(const BenchResult &r) {
+  std::printf("%-13s %-28s %8.0f %6d %2d %-10s %11.2f %10.3f %12.1f",
+              r.group.toRawUTF8(), r.name.toRawUTF8(), r.sampleRate,
+              r.blockSize, r.numChannels, r.automation.toRawUTF8(), r.nsMean,
+              r.nsStdDev(), r.realtimeFactor());
+  if (r.group == "aliasing")
+    std::printf("   aliasing %6.1f dBc, fundamental %6.2f dBFS",
+                r.aliasingDb, r.fundamentalDb);
+  if (r.group == "instances")
+    std::printf("   setup %8.3f ms/instance, %d pre-emphasis table(s)",
+                r.setupMs, r.numTables);
+  if (r.group == "editor")
+    std::printf("   open %8.3f ms", r.setupMs);
+  if (r.group == "state")
+    std::printf("   %8.3f us/call, %d bytes", r.usPerCall, r.stateBytes);
+  std::printf("\n");
+  std::fflush(stdout);
+}
+
+bool writeJson(const juce::File &file, const BenchSettings &settings,
+               const std::vector<BenchResult> &results) {
+  juce::Array<juce::var> entries;
+
+  for (const auto &r : results) {
+    juce::DynamicObject::Ptr entry(new juce::DynamicObject());
+    entry->setProperty("group", r.group);
+    entry->setProperty("name", r.name);
+    entry->setProperty("sampleRate", r.sampleRate);
+    entry->setProperty("blockSize", r.blockSize);
+    entry->setProperty("channels", r.numChannels);
+    entry->setProperty("automation", r.automation);
+    entry->setProperty("nsPerSample", r.nsMean);
+    entry->setProperty("nsStdDev", r.nsStdDev());
+    entry->setProperty("nsVariance", r.nsVariance);
+    entry->setProperty("nsMin", r.nsMin);
+    entry->setProperty("realtimeFactor", r.realtimeFactor());
+    if (r.group == "aliasing") {
+      entry->setProperty("aliasingDb", r.aliasingDb);
+      entry->setProperty("fundamentalDb", r.fundamentalDb);
+    }
+    if (r.group == "instances") {
+      entry->setProperty("setupMs", r.setupMs);
+      entry->setProperty("tables", r.numTables);
+    }
+    if (r.group == "editor")
+      entry->setProperty("setupMs", r.setupMs);
+    if (r.group == "state") {
+      entry->setProperty("usPerCall", r.usPerCall);
+      entry->setProperty("stateBytes", r.stateBytes);
+    }
+    entries.add(juce::var(entry.get()));
+  }
+
+  juce::DynamicObject::Ptr root(new juce::DynamicObject());
+  root->setProperty("tool", "vt2r_bench");
+  root->setProperty("label", settings.label);
+  root->setProperty("time", juce::Time::getCurrentTime().toISO8601(true));
+  root->setProperty("cpu", juce::SystemStats::getCpuModel());
+  root->setProperty("os", juce::SystemStats::getOperatingSystemName());
+  root->setProperty("runs", settings.runs);
+  root->setProperty("secondsPerRun", settings.secondsPerRun);
+  root->setProperty("results", entries);
+
+  return file.replaceWithText(juce::JSON::toString(juce::var(root.get())));
+}
+
+bool writeCsv(const juce::File &file, const BenchSettings &settings,
+              const std::vector<BenchResult> &results) {
+  juce::String csv = "label,group,name,sample_rate,block_size,channels,"
+                     "automation,ns_per_sample,ns_stddev,ns_variance,ns_min,"
+                     "realtime_factor,aliasing_db,fundamental_db,setup_ms,"
+                     "tables,us_per_call,state_bytes\n";
+
+  for (const auto &r : results) {
+    csv << settings.label.quoted() << "," << r.group << "," << r.name << ","
+        << r.sampleRate << "," << r.blockSize << "," << r.numChannels << ","
+        << r.automation << "," << r.nsMean << "," << r.nsStdDev() << ","
+        << r.nsVariance << "," << r.nsMin << "," << r.realtimeFactor();
+    if (r.group == "aliasing")
+      csv << "," << r.aliasingDb << "," << r.fundamentalDb;
+    else
+      csv << ",,";
+    if (r.group == "instances")
+      csv << "," << r.setupMs << "," << r.numTables;
+    else if (r.group == "editor")
+      csv << "," << r.setupMs << ",";
+    else
+      csv << ",,";
+    if (r.group == "state")
+      csv << "," << r.usPerCall << "," << r.stateBytes;
+    else
+      csv << ",,";
+    csv << "\n";
+  }
+
+  return file.replaceWithText(csv);
+}
+
+} // namespace
+
+//==============================================================================
+int main(int argc, char *argv[]) {
+  juce::ScopedJuceInitialiser_GUI juceInitialiser;
+  juce::ArgumentList args(argc, argv);
+
+  if (args.containsOption("-h|--help")) {
+    std::fputs(kUsage, stdout);
+    std::fputs(VT2RTools::ProcessingOptions::kUsage, stdout);
+    return 0;
+  }
+
+  auto fail = [](const juce::String &message) {
+    std::fprintf(stderr, "vt2r_bench: %s\n", message.toRawUTF8());
+    return 1;
+  };
+
+  BenchSettings settings;
+  juce::String error;
+  juce::String jsonPath, csvPath;
+
+  settings.quick = args.removeOptionIfFound("--quick");
+
+  if (args.containsOption("--only")) {
+    auto part = args.removeValueForOption("--only");
+    settings.runSweep = part == "sweep";
+    settings.runStages = part == "stages";
+    settings.runAliasing = part == "aliasing";
+    settings.runInstances = part == "instances";
+    settings.runState = part == "state";
+    settings.runEditor = part == "editor";
+    if (!settings.runSweep && !settings.runStages && !settings.runAliasing &&
+        !settings.runInstances && !settings.runState && !settings.runEditor)
+      return fail("--only must be sweep, stages, aliasing, instances, state "
+                  "or editor");
+  }
+
+  if (args.containsOption("--runs"))
+    settings.runs = args.removeValueForOption("--runs").getIntValue();
+  if (settings.runs < 1)
+    return fail("--runs must be at least 1");
+
+  if (args.containsOption("--seconds"))
+    settings.secondsPerRun =
+        args.removeValueForOption("--seconds").getDoubleValue();
+  if (settings.secondsPerRun <= 0.0)
+    return fail("--seconds must be positive");
+
+  if (args.containsOption("--label"))
+    settings.label = args.removeValueForOption("--label");
+  if (args.containsOption("--json"))
+    jsonPath = args.removeValueForOption("--json");
+  if (args.containsOption("--csv"))
+    csvPath = args.removeValueForOption("--csv");
+
+  if (!settings.processing.parse(args, error))
+    return fail(error);
+
+  if (args.size() > 0)
+    return fail("unexpected argument " + args.arguments.getReference(0).text);
+
+  // --- Sweep points ---
+  std::vector<int> blockSizes;
+  std::vector<double> sampleRates;
+
+  if (settings.quick) {
+    blockSizes = {1, 64, 512, kMaxBlockSize};
+    sampleRates = {44100.0, 96000.0, 192000.0};
+  } else {
+    for (int size = 1; size <= kMaxBlockSize; size *= 2)
+      blockSizes.push_back(size);
+    sampleRates.assign(std::begin(kSampleRates), std::end(kSampleRates));
+  }
+
+  VT2BBlackProcessor processor;
+  const auto source = makeTestSignal(kMaxChannels);
+  std::vector<BenchResult> results;
+
+  printHeader();
+
+  // First, while no instance has prepared yet
+  if (settings.runInstances) {
+    for (const auto &result : benchInstances(settings)) {
+      results.push_back(result);
+      printResult(result);
+    }
+  }
+
+  if (settings.runSweep) {
+    for (const auto &layout : kLayouts)
+      for (auto scenario : {Scenario::Steady, Scenario::Automated})
+        for (double sampleRate : sampleRates)
+          for (int blockSize : blockSizes) {
+            results.push_back(benchProcessBlock(processor, settings, source,
+                                                sampleRate, blockSize, layout,
+                                                scenario));
+            printResult(results.back());
+          }
+
+    // Bypass states and offline rendering at one typical point
+    for (const auto &layout : kLayouts)
+      for (auto scenario : {Scenario::DriveZero, Scenario::MixZero,
+                            Scenario::Silent, Scenario::Offline}) {
+        results.push_back(benchProcessBlock(processor, settings, source,
+                                            kStageSampleRate, kStateBlockSize,
+                                            layout, scenario));
+        printResult(results.back());
+      }
+  }
+
+  if (settings.runStages) {
+    for (const auto &result : benchStages(settings, source)) {
+      results.push_back(result);
+      printResult(result);
+    }
+  }
+
+  if (settings.runAliasing) {
+    for (const auto &result : benchAliasing(processor, settings)) {
+      results.push_back(result);
+      printResult(result);
+    }
+  }
+
+  if (settings.runState) {
+    for (const auto &result : benchState(processor, settings)) {
+      results.push_back(result);
+      printResult(result);
+    }
+  }
+
+  if (settings.runEditor) {
+    for (const auto &result : benchEditor(processor)) {
+      results.push_back(result);
+      printResult(result);
+    }
+  }
+
+  // --- Machine-readable output ---
+  const auto cwd = juce::File::getCurrentWorkingDirectory();
+
+  if (jsonPath.isNotEmpty() &&
+      !writeJson(cwd.getChildFile(jsonPath), settings, results))
+    return fail("cannot write JSON");
+
+  if (csvPath.isNotEmpty() &&
+      !writeCsv(cwd.getChildFile(csvPath), settings, results))
+    return fail("cannot write CSV");
+
+  return 0;
+}
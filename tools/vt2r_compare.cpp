@@ -0,0 +1,689 @@
+/*
+  ==============================================================================
+    VT-2R - EMU AUDIO
+    vt2r_compare - Reference null test
+
+    Renders deterministic signals (sines, sweep, noise, impulses) with
+    steady and automated Drive/Mix through the frozen scalar reference
+    (ReferenceProcessor.h) and through the plugin's processBlock, at several
+    sample rates and block sizes, and fails when the residual of any case
+    exceeds the threshold. Also checks the block form of the pre-emphasis
+    (mono kernel) at every Drive step and processing rate, and every
+    saturator tier against std::tanh and its documented maximum error.
+  ==============================================================================
+*/
+
+#include "PluginProcessor.h"
+#include "ReferenceProcessor.h"
+#include "ToolHelpers.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace {
+
+const char *const kUsage =
+    "Usage: vt2r_compare [options]\n"
+    "\n"
+    "  --threshold <dB>        Steady cases: max. peak residual in dBFS\n"
+    "                          (default: -90)\n"
+    "  --rms-threshold <dB>    Steady cases: max. RMS residual\n"
+    "                          (default: -110)\n"
+    "  --ramp-threshold <dB>   Automated cases: max. peak residual\n"
+    "                          (default: -40)\n"
+    "  --ramp-rms-threshold <dB>\n"
+    "                          Automated cases: max. RMS residual\n"
+    "                          (default: -60)\n"
+    "  --seconds <s>           Signal length per case (default: 0.5)\n"
+    "  --channels <n>          Channel count (default: 2)\n"
+    "  --quick                 44.1/96 kHz, blocks 64/512 only\n"
+    "  --offline               Also render every case through a second\n"
+    "                          instance in non-realtime mode (worker pool);\n"
+    "                          its output must equal the realtime output\n"
+    "                          bit for bit\n"
+    "  --verbose               Print passing cases too\n";
+
+const char *const kUsageNotes =
+    "\n"
+    "Oversampling defaults to off: the reference runs at the base rate, so\n"
+    "with oversampling the residual includes the anti-aliasing filters and\n"
+    "the threshold needs to be relaxed accordingly. --antialiasing adaa1\n"
+    "changes the saturator itself and --character glue adds stages the\n"
+    "reference does not have; neither nulls.\n"
+    "--offline needs --channels above one lane group (float: 8 with AVX,\n"
+    "4 with SSE/NEON) to exercise the workers, and 256+ sample blocks.\n"
+    "Automated cases differ by design: the processor takes pre-emphasis\n"
+    "coefficients once per control slice, the reference every sample.\n"
+    "The defaults suit the Precise quality; Eco needs --threshold -70.\n"
+    "The block pre-emphasis check covers the sweep's sample rates times\n"
+    "1x-8x oversampling and fails where the block form's error exceeds the\n"
+    "recursion's by more than 3 dB.\n"
+    "The saturator tiers (Eco / Normal / Precise) are always checked,\n"
+    "scalar and in float / double lanes, against std::tanh and the maximum\n"
+    "error documented in SaturationFunctions.h.\n"
+    "Exit code: 0 = every case within the thresholds, 1 = failure.\n";
+
+constexpr double kSampleRates[] = {44100.0, 48000.0, 96000.0, 192000.0};
+constexpr int kBlockSizes[] = {1, 64, 512, 4096};
+
+/** Residual limits in dBFS for one class of cases. */
+struct Thresholds {
+  double peakDb;
+  double rmsDb;
+};
+
+struct CompareSettings {
+  Thresholds steady{-90.0, -110.0};
+  Thresholds automated{-40.0, -60.0};
+  double seconds = 0.5;
+  int numChannels = 2;
+  bool quick = false;
+  bool offline = false;
+  bool verbose = false;
+  VT2RTools::ProcessingOptions processing;
+};
+
+//==============================================================================
+// Signals: deterministic, slightly different per channel
+
+using SignalGenerator =
+    std::function<float(int channel, int index, double sampleRate)>;
+
+struct SignalCase {
+  const char *name;
+  SignalGenerator generate;
+};
+
+float sine(double frequency, int channel, int index, double sampleRate) {
+  const double f = frequency * (1.0 + 0.01 * channel);
+  return float(0.5 * std::sin(juce::MathConstants<double>::twoPi * f *
+                              double(index) / sampleRate));
+}
+
+/** Hash noise: the same values for any block size / call order. */
+float hashNoise(int channel, int index) {
+  auto x = juce::uint32(index) * 0x9e3779b1u +
+           juce::uint32(channel) * 0x85ebca6bu;
+  x ^= x >> 16;
+  x *= 0x7feb352du;
+  x ^= x >> 15;
+  x *= 0x846ca68bu;
+  x ^= x >> 16;
+  return (float(x) / 4294967295.0f * 2.0f - 1.0f) * 0.25f;
+}
+
+std::vector<SignalCase> makeSignalCases(double seconds) {
+  std::vector<SignalCase> cases;
+
+  cases.push_back({"sine 100Hz", [](int ch, int i, double rate) {
+                     return sine(100.0, ch, i, rate);
+                   }});
+  cases.push_back({"sine 1kHz", [](int ch, int i, double rate) {
+                     return sine(1000.0, ch, i, rate);
+                   }});
+  cases.push_back({"sine 5kHz", [](int ch, int i, double rate) {
+                     return sine(5000.0, ch, i, rate);
+                   }});
+
+  // Exponential 20 Hz - 20 kHz sweep over the case length
+  cases.push_back({"sweep", [seconds](int ch, int i, double rate) {
+                     const double k = std::log(1000.0) / seconds;
+                     const double t = double(i) / rate;
+                     const double phase = juce::MathConstants<double>::twoPi *
+                                          20.0 * (std::exp(k * t) - 1.0) / k;
+                     return float(0.5 * std::sin(phase + 0.5 * ch));
+                   }});
+
+  cases.push_back({"noise", [](int ch, int i, double) {
+                     return hashNoise(ch, i);
+                   }});
+
+  // One full-scale impulse every 0.1 s (silence in between)
+  cases.push_back({"impulses", [](int ch, int i, double rate) {
+                     const int period = juce::roundToInt(rate * 0.1);
+                     return i % period == ch ? 1.0f : 0.0f;
+                   }});
+
+  return cases;
+}
+
+//==============================================================================
+// Drive / Mix (0-100) over time, evaluated at each block start
+
+struct AutomationCase {
+  const char *name;
+  bool automated; // parameters move: judged by the ramp thresholds
+  std::function<float(double seconds)> drive;
+  std::function<float(double seconds)> mix;
+};
+
+std::vector<AutomationCase> makeAutomationCases(double length) {
+  auto constant = [](float value) {
+    return [value](double) { return value; };
+  };
+
+  std::vector<AutomationCase> cases;
+  cases.push_back({"steady", false, constant(50.0f), constant(100.0f)});
+  cases.push_back({"drive ramp", true,
+                   [length](double t) { return float(100.0 * t / length); },
+                   constant(100.0f)});
+  cases.push_back({"mix ramp", true, constant(60.0f), [length](double t) {
+                     return float(100.0 * (1.0 - t / length));
+                   }});
+
+  // Jumps every 0.1 s: the smoothers restart mid-ramp
+  cases.push_back({"steps", true,
+                   [](double t) {
+                     return int(t / 0.1) % 2 == 0 ? 20.0f : 80.0f;
+                   },
+                   [](double t) {
+                     return int(t / 0.15) % 2 == 0 ? 100.0f : 50.0f;
+                   }});
+  return cases;
+}
+
+//==============================================================================
+struct CaseResult {
+  double peakResidualDb = 0.0;
+  double rmsResidualDb = 0.0;
+  bool offlineIdentical = true; // --offline: same output as realtime
+  bool passed = false;
+};
+
+double toDb(double gain) {
+  return double(juce::Decibels::gainToDecibels(gain, -200.0));
+}
+
+/**
+ * One case: the same blocks (and parameter changes at the same block
+ * starts) through both processors; the processor output is compared after
+ * removing its reported latency. offline (if not null) renders the same
+ * blocks in non-realtime mode and must match the processor exactly.
+ */
+CaseResult runCase(VT2BBlackProcessor &processor,
+                   VT2BBlackProcessor *offline,
+                   const CompareSettings &settings, const SignalCase &signal,
+                   const AutomationCase &automation, double sampleRate,
+                   int blockSize) {
+  const int numChannels = settings.numChannels;
+  auto &parameters = processor.getParameters();
+
+  // Parameters in the processor's own (snapped) values, also for the
+  // reference
+  auto applyAutomation = [&](double seconds, float &drive, float &mix) {
+    VT2RTools::setParameterValue(processor, "drive", automation.drive(seconds));
+    VT2RTools::setParameterValue(processor, "mix", automation.mix(seconds));
+    if (offline != nullptr) {
+      VT2RTools::setParameterValue(*offline, "drive",
+                                   automation.drive(seconds));
+      VT2RTools::setParameterValue(*offline, "mix", automation.mix(seconds));
+    }
+    drive = parameters.getRawParameterValue("drive")->load();
+    mix = parameters.getRawParameterValue("mix")->load();
+  };
+
+  float drive = 0.0f, mix = 0.0f;
+  applyAutomation(0.0, drive, mix);
+
+  processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+  processor.prepareToPlay(sampleRate, blockSize);
+  if (offline != nullptr) {
+    offline->setRateAndBufferSizeDetails(sampleRate, blockSize);
+    offline->prepareToPlay(sampleRate, blockSize);
+  }
+
+  VT2RTools::ReferenceProcessor reference;
+  reference.prepare(sampleRate, numChannels, drive, mix);
+
+  // --- Input, padded by the latency so both outputs cover the signal ---
+  const int length = juce::roundToInt(settings.seconds * sampleRate);
+  const int latency = processor.getLatencySamples();
+  const int total = length + latency;
+
+  juce::AudioBuffer<float> optimized(numChannels, total);
+  optimized.clear();
+  for (int ch = 0; ch < numChannels; ++ch)
+    for (int i = 0; i < length; ++i)
+      optimized.setSample(ch, i, signal.generate(ch, i, sampleRate));
+
+  juce::AudioBuffer<float> expected(optimized);
+  juce::AudioBuffer<float> offlineOutput;
+  if (offline != nullptr)
+    offlineOutput.makeCopyOf(optimized);
+
+  // --- Render ---
+  juce::MidiBuffer midi;
+  std::vector<float *> outChannels(size_t(numChannels), nullptr);
+  std::vector<float *> referenceChannels(size_t(numChannels), nullptr);
+
+  for (int start = 0; start < total; start += blockSize) {
+    const int count = juce::jmin(blockSize, total - start);
+
+    applyAutomation(double(start) / sampleRate, drive, mix);
+    reference.setTargets(drive, mix);
+
+    for (int ch = 0; ch < numChannels; ++ch) {
+      outChannels[size_t(ch)] = optimized.getWritePointer(ch, start);
+      referenceChannels[size_t(ch)] = expected.getWritePointer(ch, start);
+    }
+
+    juce::AudioBuffer<float> block(outChannels.data(), numChannels, count);
+    processor.processBlock(block, midi);
+    reference.process(referenceChannels.data(), numChannels, count);
+
+    if (offline != nullptr) {
+      for (int ch = 0; ch < numChannels; ++ch)
+        outChannels[size_t(ch)] = offlineOutput.getWritePointer(ch, start);
+
+      juce::AudioBuffer<float> offlineBlock(outChannels.data(), numChannels,
+                                            count);
+      offline->processBlock(offlineBlock, midi);
+    }
+  }
+
+  processor.releaseResources();
+  if (offline != nullptr)
+    offline->releaseResources();
+
+  // --- Null ---
+  double peak = 0.0, sumSquares = 0.0;
+
+  for (int ch = 0; ch < numChannels; ++ch) {
+    const float *out = optimized.getReadPointer(ch, latency);
+    const float *ref = expected.getReadPointer(ch);
+
+    for (int i = 0; i < length; ++i) {
+      const double residual = double(out[i]) - double(ref[i]);
+      peak = juce::jmax(peak, std::abs(residual));
+      sumSquares += residual * residual;
+    }
+  }
+
+  CaseResult result;
+
+  if (offline != nullptr)
+    for (int ch = 0; ch < numChannels; ++ch)
+      result.offlineIdentical =
+          result.offlineIdentical &&
+          std::memcmp(optimized.getReadPointer(ch),
+                      offlineOutput.getReadPointer(ch),
+                      sizeof(float) * size_t(total)) == 0;
+
+  result.peakResidualDb = toDb(peak);
+  result.rmsResidualDb =
+      toDb(std::sqrt(sumSquares / double(juce::jmax(1, length * numChannels))));
+  const auto &limits =
+      automation.automated ? settings.automated : settings.steady;
+  result.passed = result.peakResidualDb <= limits.peakDb &&
+                  result.rmsResidualDb <= limits.rmsDb &&
+                  result.offlineIdentical;
+  return result;
+}
+
+//==============================================================================
+// Block pre-emphasis: the block form (BlockBiquadMatrices, mono kernel at a
+// settled Drive) and the sample-by-sample recursion it replaces, both
+// against a double recursion with the same coefficients
+
+constexpr int kBlockCheckLength = 4101; // not a whole number of blocks
+constexpr double kBlockMarginDb = 3.0;  // block form vs. recursion error
+
+/** Leaves the pre-emphasis output as it is (the filter alone). */
+struct LinearSaturator {
+  template <typename Vector> Vector operator()(Vector x) const { return x; }
+};
+
+struct BlockCheckResult {
+  double blockDb = -200.0;     // worst peak error of the block form
+  double recursionDb = -200.0; // worst peak error of the recursion
+  float worstDrive = 0.0f;     // Drive of the block form's worst error
+  bool passed = false;
+};
+
+/** Every Drive step of the pre-emphasis table at one processing rate. */
+template <typename SampleType>
+BlockCheckResult checkBlockPreEmphasis(double rate) {
+  using Table = VT2RDSP::PreEmphasisTable<SampleType>;
+  using Vector = VT2RDSP::SIMDRegister<SampleType>;
+
+  Table table;
+  table.prepare(rate);
+
+  std::vector<SampleType> input(static_cast<size_t>(kBlockCheckLength));
+  for (int i = 0; i < kBlockCheckLength; ++i)
+    input[size_t(i)] = SampleType(hashNoise(0, i));
+  const SampleType *channels[] = {input.data()};
+
+  std::vector<Vector> block(input.size()), recursion(input.size());
+  std::vector<double> exact(input.size());
+  const VT2RDSP::GlueCoefficients<SampleType> glueCoeffs;
+  BlockCheckResult result;
+
+  for (int entry = 0; entry < Table::kNumEntries; ++entry) {
+    const auto drive = SampleType(Table::gridDrive(entry));
+    const auto coeffs = table.lookup(drive);
+    const SampleType normDrive = drive / SampleType(100);
+
+    double z1 = 0.0, z2 = 0.0;
+    for (size_t i = 0; i < input.size(); ++i) {
+      const double w =
+          double(input[i]) - double(coeffs.a1) * z1 - double(coeffs.a2) * z2;
+      exact[i] = double(coeffs.b0) * w + double(coeffs.b1) * z1 +
+                 double(coeffs.b2) * z2;
+      z2 = z1;
+      z1 = w;
+    }
+
+    VT2RDSP::interleaveLanes<1>(channels, 0, 1, kBlockCheckLength,
+                                block.data());
+    recursion = block;
+
+    VT2RDSP::LaneFilterState<SampleType> blockState, recursionState;
+    VT2RDSP::GlueLaneState<SampleType> glueState;
+    VT2RDSP::processMonoLanesConstant(
+        block.data(), kBlockCheckLength, coeffs, table.lookupBlock(drive),
+        glueCoeffs, SampleType(1), SampleType(1), normDrive, blockState,
+        glueState, LinearSaturator());
+    VT2RDSP::processWetLanesConstant<VT2RDSP::AggressiveStages>(
+        recursion.data(), kBlockCheckLength, coeffs, glueCoeffs,
+        SampleType(1), SampleType(1), normDrive, recursionState, glueState,
+        LinearSaturator());
+
+    double blockPeak = 0.0, recursionPeak = 0.0;
+    for (size_t i = 0; i < input.size(); ++i) {
+      blockPeak = juce::jmax(
+          blockPeak, std::abs(double(block[i].firstLane()) - exact[i]));
+      recursionPeak = juce::jmax(
+          recursionPeak, std::abs(double(recursion[i].firstLane()) - exact[i]));
+    }
+
+    if (toDb(blockPeak) > result.blockDb) {
+      result.blockDb = toDb(blockPeak);
+      result.worstDrive = float(drive);
+    }
+    result.recursionDb = juce::jmax(result.recursionDb, toDb(recursionPeak));
+  }
+
+  result.passed = result.blockDb <= result.recursionDb + kBlockMarginDb;
+  return result;
+}
+
+//==============================================================================
+// Saturator tiers against std::tanh in double: a fine sweep of [-20, 20]
+// plus the points where an implementation changes branch
+
+struct TanhCheckResult {
+  double maxError = 0.0;
+  double worstInput = 0.0;
+
+  void add(double input, double output) {
+    const double error = std::abs(output - std::tanh(input));
+    if (error > maxError) {
+      maxError = error;
+      worstInput = input;
+    }
+  }
+};
+
+/** Sweep inputs, all exactly representable in float. */
+std::vector<float> makeTanhCheckInputs() {
+  constexpr float kSweepRange = 20.0f;
+  constexpr float kSweepStep = 1.0f / 8192.0f; // 64 points per table cell
+
+  std::vector<float> edges = {0.0f,
+                              1.0e-30f,
+                              1.0e-6f,
+                              VT2RDSP::TanhRational::kClamp,
+                              VT2RDSP::TanhPolynomial::kSmall,
+                              VT2RDSP::TanhPolynomial::kLarge,
+                              VT2RDSP::TanhTable::kRange,
+                              100.0f,
+                              1.0e6f};
+
+  // Range reduction: n = round(-2|x| log2(e)) steps at odd multiples of
+  // ln2 / 4 (up to kLarge)
+  const double ln2 = std::log(2.0);
+  for (int k = 0; (2 * k + 1) * ln2 / 4.0 <= 9.0; ++k)
+    edges.push_back(float((2 * k + 1) * ln2 / 4.0));
+
+  std::vector<float> inputs;
+  for (float x = -kSweepRange; x <= kSweepRange; x += kSweepStep)
+    inputs.push_back(x);
+
+  for (float edge : edges)
+    for (float x : {std::nextafter(edge, -1.0e9f), edge,
+                    std::nextafter(edge, 1.0e9f)})
+      inputs.insert(inputs.end(), {x, -x});
+
+  return inputs;
+}
+
+template <typename Saturator>
+TanhCheckResult checkTanhScalar(const std::vector<float> &inputs) {
+  const Saturator saturate;
+  TanhCheckResult result;
+  for (float x : inputs)
+    result.add(double(x), double(saturate(x)));
+  return result;
+}
+
+template <typename Saturator, typename SampleType>
+TanhCheckResult checkTanhLanes(const std::vector<float> &inputs) {
+  using Vector = VT2RDSP::SIMDRegister<SampleType>;
+  const Saturator saturate;
+  TanhCheckResult result;
+
+  alignas(Vector::kAlignment) SampleType lanes[Vector::kNumLanes];
+  for (size_t start = 0; start < inputs.size(); start += Vector::kNumLanes) {
+    const auto count =
+        juce::jmin(size_t(Vector::kNumLanes), inputs.size() - start);
+    for (size_t lane = 0; lane < size_t(Vector::kNumLanes); ++lane)
+      lanes[lane] = SampleType(inputs[start + juce::jmin(lane, count - 1)]);
+
+    saturate(Vector::load(lanes)).store(lanes);
+    for (size_t lane = 0; lane < count; ++lane)
+      result.add(double(inputs[start + lane]), double(lanes[lane]));
+  }
+  return result;
+}
+
+struct TanhTierResult {
+  const char *name;
+  double bound;
+  TanhCheckResult scalar, floatLanes, doubleLanes;
+
+  bool passed() const {
+    return scalar.maxError <= bound && floatLanes.maxError <= bound &&
+           doubleLanes.maxError <= bound;
+  }
+};
+
+template <typename Saturator>
+TanhTierResult checkTanhTier(const char *name,
+                             const std::vector<float> &inputs) {
+  return {name, Saturator::kMaxError, checkTanhScalar<Saturator>(inputs),
+          checkTanhLanes<Saturator, float>(inputs),
+          checkTanhLanes<Saturator, double>(inputs)};
+}
+
+} // namespace
+
+//==============================================================================
+int main(int argc, char *argv[]) {
+  juce::ScopedJuceInitialiser_GUI juceInitialiser;
+  juce::ArgumentList args(argc, argv);
+
+  if (args.containsOption("-h|--help")) {
+    std::fputs(kUsage, stdout);
+    std::fputs(VT2RTools::ProcessingOptions::kUsage, stdout);
+    std::fputs(kUsageNotes, stdout);
+    return 0;
+  }
+
+  CompareSettings settings;
+  juce::String error;
+
+  auto fail = [](const juce::String &message) {
+    std::fprintf(stderr, "vt2r_compare: %s\n", message.toRawUTF8());
+    return 1;
+  };
+
+  // --- Options ---
+  auto parseDb = [&](const char *option, double &value) {
+    if (args.containsOption(option))
+      value = args.removeValueForOption(option).getDoubleValue();
+  };
+
+  parseDb("--threshold", settings.steady.peakDb);
+  parseDb("--rms-threshold", settings.steady.rmsDb);
+  parseDb("--ramp-threshold", settings.automated.peakDb);
+  parseDb("--ramp-rms-threshold", settings.automated.rmsDb);
+
+  if (args.containsOption("--seconds"))
+    settings.seconds = args.removeValueForOption("--seconds").getDoubleValue();
+  if (settings.seconds <= 0.0)
+    return fail("--seconds must be positive");
+
+  if (args.containsOption("--channels"))
+    settings.numChannels =
+        args.removeValueForOption("--channels").getIntValue();
+  if (settings.numChannels < 1)
+    return fail("--channels must be at least 1");
+
+  settings.quick = args.removeOptionIfFound("--quick");
+  settings.offline = args.removeOptionIfFound("--offline");
+  settings.verbose = args.removeOptionIfFound("--verbose");
+
+  if (!settings.processing.parse(args, error))
+    return fail(error);
+
+  // The reference has no oversampling
+  if (settings.processing.oversampling < 0)
+    settings.processing.oversampling = 0;
+
+  if (args.size() > 0)
+    return fail("unexpected argument " + args.arguments.getReference(0).text);
+
+  // --- Sweep points ---
+  std::vector<double> sampleRates(std::begin(kSampleRates),
+                                  std::end(kSampleRates));
+  std::vector<int> blockSizes(std::begin(kBlockSizes), std::end(kBlockSizes));
+
+  if (settings.quick) {
+    sampleRates = {44100.0, 96000.0};
+    blockSizes = {64, 512};
+  }
+
+  VT2BBlackProcessor processor;
+  if (!VT2RTools::setChannelLayout(processor, settings.numChannels))
+    return fail("channel layout rejected by the processor");
+  settings.processing.apply(processor);
+
+  // Non-realtime twin: same layout and settings, lane groups on workers
+  std::unique_ptr<VT2BBlackProcessor> offline;
+  if (settings.offline) {
+    offline = std::make_unique<VT2BBlackProcessor>();
+    if (!VT2RTools::setChannelLayout(*offline, settings.numChannels))
+      return fail("channel layout rejected by the processor");
+    settings.processing.apply(*offline);
+    offline->setNonRealtime(true);
+  }
+
+  const auto signals = makeSignalCases(settings.seconds);
+  const auto automations = makeAutomationCases(settings.seconds);
+
+  int numCases = 0, numFailed = 0;
+  double worstSteadyDb = -200.0, worstAutomatedDb = -200.0;
+
+  std::printf("%-10s %-10s %8s %6s %12s %12s\n", "signal", "automation",
+              "rate", "block", "peak dBFS", "rms dBFS");
+
+  for (const auto &signal : signals)
+    for (const auto &automation : automations)
+      for (double sampleRate : sampleRates)
+        for (int blockSize : blockSizes) {
+          const auto result =
+              runCase(processor, offline.get(), settings, signal, automation,
+                      sampleRate, blockSize);
+          ++numCases;
+          auto &worst =
+              automation.automated ? worstAutomatedDb : worstSteadyDb;
+          worst = juce::jmax(worst, result.peakResidualDb);
+
+          if (!result.passed)
+            ++numFailed;
+
+          if (!result.passed || settings.verbose)
+            std::printf("%-10s %-10s %8.0f %6d %12.1f %12.1f%s\n", signal.name,
+                        automation.name, sampleRate, blockSize,
+                        result.peakResidualDb, result.rmsResidualDb,
+                        result.passed              ? ""
+                        : result.offlineIdentical ? "  FAIL"
+                                                  : "  FAIL (offline differs)");
+        }
+
+  std::printf("\n%d cases, %d failed\n", numCases, numFailed);
+  std::printf("worst peak residual: steady %.1f dBFS (limit %.1f), "
+              "automated %.1f dBFS (limit %.1f)\n",
+              worstSteadyDb, settings.steady.peakDb, worstAutomatedDb,
+              settings.automated.peakDb);
+
+  // --- Block pre-emphasis: every Drive step at every processing rate ---
+  std::set<double> processingRates;
+  for (double sampleRate : sampleRates)
+    for (int factor = 1; factor <= 8; factor *= 2)
+      processingRates.insert(sampleRate * factor);
+
+  std::printf("\nblock pre-emphasis (mono, settled Drive), every Drive step, "
+              "peak error against a double recursion:\n");
+  std::printf("%-9s %9s %12s %15s %7s\n", "precision", "rate", "block dBFS",
+              "recursion dBFS", "drive");
+
+  int numBlockFailed = 0;
+  auto reportBlockCheck = [&](const char *precision, double rate,
+                              const BlockCheckResult &result) {
+    numBlockFailed += result.passed ? 0 : 1;
+    std::printf("%-9s %9.0f %12.1f %15.1f %7.1f%s\n", precision, rate,
+                result.blockDb, result.recursionDb, result.worstDrive,
+                result.passed ? "" : "  FAIL");
+  };
+
+  for (double rate : processingRates) {
+    reportBlockCheck("float", rate, checkBlockPreEmphasis<float>(rate));
+    reportBlockCheck("double", rate, checkBlockPreEmphasis<double>(rate));
+  }
+
+  std::printf("%d rates, %d failed (limit: recursion error + %.0f dB)\n",
+              int(processingRates.size()) * 2, numBlockFailed,
+              kBlockMarginDb);
+
+  // --- Saturator tiers: documented maximum error against std::tanh ---
+  const auto tanhInputs = makeTanhCheckInputs();
+  const TanhTierResult tiers[] = {
+      checkTanhTier<VT2RDSP::TanhRational>("Eco", tanhInputs),
+      checkTanhTier<VT2RDSP::TanhTable>("Normal", tanhInputs),
+      checkTanhTier<VT2RDSP::TanhPolynomial>("Precise", tanhInputs)};
+
+  std::printf("\nsaturator tiers, max. error against std::tanh (double), "
+              "%d inputs in [-20, 20] plus branch edges:\n",
+              int(tanhInputs.size()));
+  std::printf("%-8s %10s %10s %12s %12s\n", "tier", "limit", "scalar",
+              "float lanes", "double lanes");
+
+  int numTiersFailed = 0;
+  for (const auto &tier : tiers) {
+    numTiersFailed += tier.passed() ? 0 : 1;
+    std::printf("%-8s %10.2e %10.2e %12.2e %12.2e%s\n", tier.name, tier.bound,
+                tier.scalar.maxError, tier.floatLanes.maxError,
+                tier.doubleLanes.maxError, tier.passed() ? "" : "  FAIL");
+  }
+  std::printf("%d tiers, %d failed\n", int(std::size(tiers)), numTiersFailed);
+
+  return numFailed == 0 && numBlockFailed == 0 && numTiersFailed == 0 ? 0 : 1;
+}
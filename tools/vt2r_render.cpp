@@ -0,0 +1,518 @@
+/*
+  ==============================================================================
+    VT-2R - EMU AUDIO
+    vt2r_render - Offline Renderer
+
+    Streams WAV/AIFF files through VT2BBlackProcessor without a DAW.
+    One processor per worker thread, files distributed across the workers.
+  ==============================================================================
+*/
+
+#include "PluginProcessor.h"
+#include "ToolHelpers.h"
+
+#include <juce_audio_formats/juce_audio_formats.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int kDefaultBlockSize = 512;
+constexpr int kBlocksPerMapWindow = 256; // input is re-mapped per window
+
+const char *const kUsageOptions =
+    "Usage: vt2r_render [options] <input.wav|aif>...\n"
+    "\n"
+    "  -o, --output-dir <dir>  Output directory (default: next to input)\n"
+    "  --suffix <text>         Appended to output names (default: _vt2r)\n"
+    "  --drive <automation>    0-100 (default: plugin default)\n"
+    "  --mix <automation>      0-100 (default: plugin default)\n"
+    "  --bits <n>              Output bit depth (default: same as input)\n"
+    "  --block <samples>       Processing block size (default: 512)\n"
+    "  -j, --jobs <n>          Worker threads (default: CPU count)\n";
+
+const char *const kUsageAutomation =
+    "\n"
+    "Automation is a constant (\"40\"), breakpoints in seconds\n"
+    "(\"0:0,2.5:80,10:20\", linear in between) or @file with breakpoints.\n";
+
+//==============================================================================
+/** Constant value or linear breakpoint curve over time (seconds). */
+class Automation {
+public:
+  bool isSet() const { return !points.empty(); }
+
+  /**
+   * Parses "value", "t:v,t:v,..." or "@file" (same syntax, any
+   * separator of , ; or whitespace). Times must not decrease.
+   */
+  static bool parse(const juce::String &text, float minValue, float maxValue,
+                    Automation &result, juce::String &error) {
+    auto source = text.trim();
+
+    if (source.startsWithChar('@')) {
+      auto file = juce::File::getCurrentWorkingDirectory().getChildFile(
+          source.substring(1));
+      if (!file.existsAsFile()) {
+        error = "automation file not found: " + file.getFullPathName();
+        return false;
+      }
+      source = file.loadFileAsString();
+    }
+
+    auto tokens = juce::StringArray::fromTokens(source, ",; \t\r\n", "");
+    tokens.removeEmptyStrings();
+
+    if (tokens.isEmpty()) {
+      error = "empty automation";
+      return false;
+    }
+
+    result.points.clear();
+
+    for (const auto &token : tokens) {
+      const bool isPoint = token.containsChar(':');
+      auto timeText = isPoint ? token.upToFirstOccurrenceOf(":", false, false)
+                              : juce::String("0");
+      auto valueText =
+          isPoint ? token.fromFirstOccurrenceOf(":", false, false) : token;
+
+      if (!isNumber(timeText) || !isNumber(valueText) ||
+          (!isPoint && tokens.size() > 1)) {
+        error = "malformed automation point '" + token + "'";
+        return false;
+      }
+
+      const double time = timeText.getDoubleValue();
+      const float value = valueText.getFloatValue();
+
+      if (value < minValue || value > maxValue) {
+        error = "automation value " + valueText + " outside " +
+                juce::String(minValue) + "-" + juce::String(maxValue);
+        return false;
+      }
+      if (!result.points.empty() && time < result.points.back().first) {
+        error = "automation times must not decrease ('" + token + "')";
+        return false;
+      }
+
+      result.points.emplace_back(time, value);
+    }
+
+    return true;
+  }
+
+  float valueAt(double seconds) const {
+    if (seconds <= points.front().first)
+      return points.front().second;
+    if (seconds >= points.back().first)
+      return points.back().second;
+
+    auto next = std::upper_bound(
+        points.begin(), points.end(), seconds,
+        [](double t, const auto &point) { return t < point.first; });
+    auto prev = std::prev(next);
+
+    const double span = next->first - prev->first;
+    const double t = span > 0.0 ? (seconds - prev->first) / span : 1.0;
+    return float(prev->second + t * (next->second - prev->second));
+  }
+
+private:
+  static bool isNumber(const juce::String &text) {
+    return text.isNotEmpty() && text.containsOnly("0123456789.-+eE");
+  }
+
+  std::vector<std::pair<double, float>> points;
+};
+
+//==============================================================================
+struct RenderSettings {
+  Automation drive;
+  Automation mix;
+  VT2RTools::ProcessingOptions processing;
+  int bitDepth = 0; // 0: same as input
+  int blockSize = kDefaultBlockSize;
+  juce::File outputDirectory; // empty: next to the input
+  juce::String suffix = "_vt2r";
+};
+
+struct RenderResult {
+  juce::File output;
+  double sampleRate = 0.0;
+  int numChannels = 0;
+  double audioSeconds = 0.0;
+  double renderSeconds = 0.0;
+  juce::String error;
+};
+
+//==============================================================================
+/**
+ * Block reader over a memory-mapped window of the input. Only the current
+ * window (kBlocksPerMapWindow blocks) is mapped, so resident memory stays
+ * flat regardless of file length. Falls back to the format's streaming
+ * reader when the file cannot be mapped (e.g. compressed AIFC).
+ */
+class StreamingReader {
+public:
+  StreamingReader(juce::AudioFormat &format, const juce::File &file,
+                  int blockSize)
+      : windowLength(juce::int64(blockSize) * kBlocksPerMapWindow) {
+    mapped.reset(format.createMemoryMappedReader(file));
+
+    if (mapped != nullptr) {
+      source = mapped.get();
+    } else {
+      streamed.reset(format.createReaderFor(file.createInputStream().release(),
+                                            true));
+      source = streamed.get();
+    }
+  }
+
+  juce::AudioFormatReader *getReader() const { return source; }
+
+  /** Reads numSamples from start; past the end of the file reads silence. */
+  bool read(float *const *dest, int numChannels, juce::int64 start,
+            int numSamples) {
+    const int available = int(juce::jlimit<juce::int64>(
+        0, numSamples, source->lengthInSamples - start));
+
+    if (available > 0) {
+      const juce::Range<juce::int64> needed(start, start + available);
+
+      if (mapped != nullptr && !mapped->getMappedSection().contains(needed)) {
+        const juce::Range<juce::int64> window(
+            start, juce::jmin(source->lengthInSamples, start + windowLength));
+        if (!mapped->mapSectionOfFile(window))
+          return false;
+      }
+
+      if (!source->read(dest, numChannels, start, available))
+        return false;
+    }
+
+    for (int ch = 0; ch < numChannels; ++ch)
+      juce::FloatVectorOperations::clear(dest[ch] + available,
+                                         numSamples - available);
+    return true;
+  }
+
+private:
+  const juce::int64 windowLength;
+  std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped;
+  std::unique_ptr<juce::AudioFormatReader> streamed;
+  juce::AudioFormatReader *source = nullptr;
+};
+
+//==============================================================================
+juce::File getOutputFile(const juce::File &input,
+                         const RenderSettings &settings) {
+  auto directory = settings.outputDirectory == juce::File()
+                       ? input.getParentDirectory()
+                       : settings.outputDirectory;
+  return directory.getChildFile(input.getFileNameWithoutExtension() +
+                                settings.suffix + input.getFileExtension());
+}
+
+/**
+ * Renders one file in blockSize chunks: read -> processBlock -> write.
+ * The plugin latency is compensated, so the output lines up with (and has
+ * the same length as) the input.
+ */
+RenderResult renderFile(VT2BBlackProcessor &processor,
+                        juce::AudioFormatManager &formats,
+                        const juce::File &input,
+                        const RenderSettings &settings) {
+  RenderResult result;
+  result.output = getOutputFile(input, settings);
+
+  auto *format = formats.findFormatForFileExtension(input.getFileExtension());
+  if (format == nullptr) {
+    result.error = "not a WAV/AIFF file";
+    return result;
+  }
+
+  StreamingReader in(*format, input, settings.blockSize);
+  auto *reader = in.getReader();
+  if (reader == nullptr) {
+    result.error = "cannot read file";
+    return result;
+  }
+
+  const int numChannels = int(reader->numChannels);
+  const double sampleRate = reader->sampleRate;
+  const juce::int64 totalSamples = reader->lengthInSamples;
+  result.sampleRate = sampleRate;
+  result.numChannels = numChannels;
+
+  if (numChannels < 1) {
+    result.error = "file has no audio channels";
+    return result;
+  }
+  if (result.output == input) {
+    result.error = "output would overwrite the input";
+    return result;
+  }
+
+  // --- Processor setup ---
+  if (!VT2RTools::setChannelLayout(processor, numChannels)) {
+    result.error = "channel layout rejected by the processor";
+    return result;
+  }
+
+  settings.processing.apply(processor);
+
+  auto applyAutomation = [&](double seconds) {
+    if (settings.drive.isSet())
+      VT2RTools::setParameterValue(processor, "drive",
+                                   settings.drive.valueAt(seconds));
+    if (settings.mix.isSet())
+      VT2RTools::setParameterValue(processor, "mix",
+                                   settings.mix.valueAt(seconds));
+  };
+
+  applyAutomation(0.0);
+
+  processor.setNonRealtime(true);
+  processor.setRateAndBufferSizeDetails(sampleRate, settings.blockSize);
+  processor.prepareToPlay(sampleRate, settings.blockSize);
+
+  // --- Output ---
+  const int bitDepth =
+      settings.bitDepth > 0 ? settings.bitDepth : int(reader->bitsPerSample);
+  if (!format->getPossibleBitDepths().contains(bitDepth)) {
+    result.error = juce::String(bitDepth) + "-bit output not supported";
+    return result;
+  }
+
+  result.output.deleteFile(); // FileOutputStream appends otherwise
+  auto stream = std::make_unique<juce::FileOutputStream>(result.output);
+  if (!stream->openedOk()) {
+    result.error = "cannot create " + result.output.getFullPathName();
+    return result;
+  }
+
+  std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(
+      stream.get(), sampleRate, juce::uint32(numChannels), bitDepth,
+      reader->metadataValues, 0));
+  if (writer == nullptr) {
+    result.error = "cannot create writer";
+    return result;
+  }
+  stream.release(); // owned by the writer
+
+  // --- Render ---
+  const int blockSize = settings.blockSize;
+  juce::AudioBuffer<float> buffer(numChannels, blockSize);
+  std::vector<const float *> channels(size_t(numChannels), nullptr);
+  juce::MidiBuffer midi;
+
+  juce::int64 readPosition = 0;
+  juce::int64 written = 0;
+  juce::int64 latencyToSkip = processor.getLatencySamples();
+
+  const double startTime = juce::Time::getMillisecondCounterHiRes();
+
+  while (written < totalSamples) {
+    applyAutomation(double(readPosition) / sampleRate);
+
+    if (!in.read(buffer.getArrayOfWritePointers(), numChannels, readPosition,
+                 blockSize)) {
+      result.error = "read error at sample " + juce::String(readPosition);
+      return result;
+    }
+
+    processor.processBlock(buffer, midi);
+    readPosition += blockSize;
+
+    // Drop the first getLatencySamples() outputs, then write up to the
+    // input length (the last blocks flush the delay line with silence)
+    const int offset = int(juce::jmin<juce::int64>(latencyToSkip, blockSize));
+    latencyToSkip -= offset;
+
+    const int count = int(
+        juce::jmin<juce::int64>(blockSize - offset, totalSamples - written));
+
+    if (count > 0) {
+      for (int ch = 0; ch < numChannels; ++ch)
+        channels[size_t(ch)] = buffer.getReadPointer(ch, offset);
+
+      if (!writer->writeFromFloatArrays(channels.data(), numChannels,
+                                        count)) {
+        result.error = "write error";
+        return result;
+      }
+      written += count;
+    }
+  }
+
+  writer.reset(); // flush + finalise the header before timing stops
+  processor.releaseResources();
+
+  result.renderSeconds =
+      (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+  result.audioSeconds = double(totalSamples) / sampleRate;
+  return result;
+}
+
+} // namespace
+
+//==============================================================================
+int main(int argc, char *argv[]) {
+  juce::ScopedJuceInitialiser_GUI juceInitialiser;
+  juce::ArgumentList args(argc, argv);
+
+  if (args.size() == 0 || args.containsOption("-h|--help")) {
+    auto *out = args.size() == 0 ? stderr : stdout;
+    std::fputs(kUsageOptions, out);
+    std::fputs(VT2RTools::ProcessingOptions::kUsage, out);
+    std::fputs(kUsageAutomation, out);
+    return args.size() == 0 ? 1 : 0;
+  }
+
+  RenderSettings settings;
+  int numJobs = juce::SystemStats::getNumCpus();
+  juce::String error;
+
+  auto fail = [](const juce::String &message) {
+    std::fprintf(stderr, "vt2r_render: %s\n", message.toRawUTF8());
+    return 1;
+  };
+
+  // --- Options (removed from args, leaving the input files) ---
+  if (args.containsOption("-o|--output-dir")) {
+    settings.outputDirectory = juce::File::getCurrentWorkingDirectory()
+                                   .getChildFile(args.removeValueForOption(
+                                       "-o|--output-dir"));
+    if (!settings.outputDirectory.createDirectory())
+      return fail("cannot create output directory");
+  }
+
+  if (args.containsOption("--suffix"))
+    settings.suffix = args.removeValueForOption("--suffix");
+
+  if (args.containsOption("--drive") &&
+      !Automation::parse(args.removeValueForOption("--drive"),
+                         VT2RConstants::kDriveMin, VT2RConstants::kDriveMax,
+                         settings.drive, error))
+    return fail("--drive: " + error);
+
+  if (args.containsOption("--mix") &&
+      !Automation::parse(args.removeValueForOption("--mix"),
+                         VT2RConstants::kMixMin, VT2RConstants::kMixMax,
+                         settings.mix, error))
+    return fail("--mix: " + error);
+
+  if (!settings.processing.parse(args, error))
+    return fail(error);
+
+  if (args.containsOption("--bits"))
+    settings.bitDepth = args.removeValueForOption("--bits").getIntValue();
+
+  if (args.containsOption("--block"))
+    settings.blockSize = args.removeValueForOption("--block").getIntValue();
+  if (settings.blockSize < 1)
+    return fail("--block must be at least 1");
+
+  if (args.containsOption("-j|--jobs"))
+    numJobs = args.removeValueForOption("-j|--jobs").getIntValue();
+  if (numJobs < 1)
+    return fail("--jobs must be at least 1");
+
+  juce::Array<juce::File> inputs;
+  for (const auto &arg : args.arguments) {
+    if (arg.isOption())
+      return fail("unknown option " + arg.text);
+
+    auto file = arg.resolveAsFile();
+    if (!file.existsAsFile())
+      return fail("file not found: " + arg.text);
+
+    inputs.add(file);
+  }
+
+  if (inputs.isEmpty())
+    return fail("no input files");
+
+  // --- Workers: one processor each, files handed out in order ---
+  const int numWorkers = juce::jmin(numJobs, inputs.size());
+
+  std::vector<std::unique_ptr<VT2BBlackProcessor>> processors;
+  for (int i = 0; i < numWorkers; ++i)
+    processors.push_back(std::make_unique<VT2BBlackProcessor>());
+
+  std::vector<RenderResult> results(size_t(inputs.size()));
+  std::atomic<int> nextInput{0};
+  std::atomic<int> numDone{0};
+  std::mutex printLock;
+
+  const double startTime = juce::Time::getMillisecondCounterHiRes();
+
+  auto worker = [&](VT2BBlackProcessor &processor) {
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    for (int i = nextInput++; i < inputs.size(); i = nextInput++) {
+      const auto &input = inputs.getReference(i);
+      auto &result = results[size_t(i)];
+      result = renderFile(processor, formats, input, settings);
+
+      std::lock_guard<std::mutex> lock(printLock);
+      const int done = ++numDone;
+
+      if (result.error.isNotEmpty()) {
+        std::fprintf(stderr, "[%3d/%d] %s: FAILED (%s)\n", done,
+                     inputs.size(), input.getFileName().toRawUTF8(),
+                     result.error.toRawUTF8());
+      } else {
+        std::printf("[%3d/%d] %s -> %s  %.0f Hz %d ch  %.1f s in %.2f s "
+                    "(%.1fx realtime)\n",
+                    done, inputs.size(), input.getFileName().toRawUTF8(),
+                    result.output.getFileName().toRawUTF8(), result.sampleRate,
+                    result.numChannels, result.audioSeconds,
+                    result.renderSeconds,
+                    result.audioSeconds /
+                        juce::jmax(result.renderSeconds, 1.0e-9));
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (auto &processor : processors)
+    threads.emplace_back(worker, std::ref(*processor));
+  for (auto &thread : threads)
+    thread.join();
+
+  const double wallSeconds =
+      (juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0;
+
+  // --- Summary (realtime multiples for render-farm sizing) ---
+  double audioSeconds = 0.0;
+  double renderSeconds = 0.0;
+  int numFailed = 0;
+
+  for (const auto &result : results) {
+    if (result.error.isNotEmpty()) {
+      ++numFailed;
+      continue;
+    }
+    audioSeconds += result.audioSeconds;
+    renderSeconds += result.renderSeconds;
+  }
+
+  std::printf("\nRendered %d of %d files: %.1f s of audio in %.2f s\n",
+              inputs.size() - numFailed, inputs.size(), audioSeconds,
+              wallSeconds);
+  std::printf("Throughput: %.1fx realtime with %d workers, "
+              "%.1fx realtime per worker\n",
+              audioSeconds / juce::jmax(wallSeconds, 1.0e-9), numWorkers,
+              audioSeconds / juce::jmax(renderSeconds, 1.0e-9));
+
+  return numFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,620 @@
+/*
+  ==============================================================================
+    VT-2R - EMU AUDIO
+    vt2r_stress - Multi-instance Scaling Stress Test
+
+    Many processors in one process, driven from a pool of threads the way a
+    multithreaded host processes its graph: every host cycle, each instance
+    renders one block with its own layout and randomized automation. Reports
+    throughput, per-block latency percentiles and how well the throughput
+    scales as threads are added (false sharing, shared state contention and
+    cache thrash all show up as lost efficiency).
+  ==============================================================================
+*/
+
+#include "PluginProcessor.h"
+#include "ToolHelpers.h"
+#include "TraceMarkers.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int kSourceLength = 8192; // looped test signal
+constexpr double kWarmUpSeconds = 0.1;
+
+const char *const kUsage =
+    "Usage: vt2r_stress [options]\n"
+    "\n"
+    "  --instances <n>         Plugin instances (default: 150)\n"
+    "  --threads <list>        Thread counts to run, e.g. 1,2,4,8\n"
+    "                          (default: 1, 2, 4 ... up to the CPU count)\n"
+    "  --block <n>             Block size (default: 64)\n"
+    "  --rate <hz>             Sample rate (default: 48000)\n"
+    "  --seconds <s>           Audio per instance and thread count\n"
+    "                          (default: 1)\n"
+    "  --layout <l>            mixed | mono | stereo (default: mixed)\n"
+    "  --automated <share>     Share of automated instances, 0-1\n"
+    "                          (default: 0.5)\n"
+    "  --schedule <s>          dynamic | static (default: dynamic)\n"
+    "  --seed <n>              Random layouts / automation (default: 1)\n"
+    "  --label <text>          Stored with the results (e.g. commit id)\n"
+    "  --json <file>           Write results as JSON\n"
+    "  --csv <file>            Write results as CSV\n";
+
+//==============================================================================
+struct StressSettings {
+  int numInstances = 150;
+  std::vector<int> threadCounts;
+  int blockSize = 64;
+  double sampleRate = 48000.0;
+  double seconds = 1.0;
+  int layout = 0; // mixed, mono, stereo
+  double automatedShare = 0.5;
+  bool staticSchedule = false;
+  juce::uint32 seed = 1;
+  juce::String label;
+  VT2RTools::ProcessingOptions processing;
+
+  /** The realtime budget of one host cycle. */
+  double budgetUs() const { return 1.0e6 * double(blockSize) / sampleRate; }
+};
+
+struct InstanceLayout {
+  int numInputs, numOutputs;
+  const char *name;
+};
+
+constexpr InstanceLayout kMono{1, 1, "mono"};
+constexpr InstanceLayout kMonoToStereo{1, 2, "mono>stereo"};
+constexpr InstanceLayout kStereo{2, 2, "stereo"};
+
+/** Results for one thread count; latencies in microseconds. */
+struct StressResult {
+  int numThreads = 0;
+  double realtimeFactor = 0.0; // instance-seconds of audio per second
+  double efficiency = 0.0;     // per-thread throughput vs. the first run
+  double blockP50 = 0.0, blockP99 = 0.0, blockP999 = 0.0, blockMax = 0.0;
+  double cycleP50 = 0.0, cycleP99 = 0.0, cycleMax = 0.0;
+  double overBudget = 0.0; // share of cycles longer than budgetUs()
+};
+
+//==============================================================================
+/**
+ * One plugin instance on the host's graph: its own buffer, its own slice of
+ * the test signal and, if automated, a random walk of Drive and Mix ramps
+ * (10 ms to 0.5 s each, so some are close to steps).
+ */
+struct Instance {
+  VT2BBlackProcessor processor;
+  InstanceLayout layout = kStereo;
+  juce::AudioBuffer<float> buffer;
+  juce::MidiBuffer midi;
+  const juce::AudioBuffer<float> *source = nullptr;
+  int position = 0;
+
+  bool automated = false;
+  std::mt19937 random;
+  float drive = 50.0f, mix = 100.0f;
+  float driveTarget = 50.0f, mixTarget = 100.0f;
+  int rampBlocks = 0;
+
+  void prepare(const StressSettings &settings) {
+    VT2RTools::setChannelLayout(processor, layout.numInputs,
+                                layout.numOutputs);
+    settings.processing.apply(processor);
+    VT2RTools::setParameterValue(processor, "drive", drive);
+    VT2RTools::setParameterValue(processor, "mix", mix);
+
+    processor.setRateAndBufferSizeDetails(settings.sampleRate,
+                                          settings.blockSize);
+    processor.prepareToPlay(settings.sampleRate, settings.blockSize);
+    buffer.setSize(layout.numOutputs, settings.blockSize);
+  }
+
+  void automate(const StressSettings &settings) {
+    if (rampBlocks == 0) {
+      std::uniform_real_distribution<float> value(0.0f, 100.0f);
+      std::uniform_real_distribution<double> seconds(0.01, 0.5);
+      driveTarget = value(random);
+      mixTarget = value(random);
+      rampBlocks = std::max(1, int(seconds(random) * settings.sampleRate /
+                                   double(settings.blockSize)));
+    }
+
+    drive += (driveTarget - drive) / float(rampBlocks);
+    mix += (mixTarget - mix) / float(rampBlocks);
+    --rampBlocks;
+
+    VT2RTools::setParameterValue(processor, "drive", drive);
+    VT2RTools::setParameterValue(processor, "mix", mix);
+  }
+
+  /** One block, as the host's callback would run it. */
+  void process(const StressSettings &settings) {
+    if (automated)
+      automate(settings);
+
+    const int numSamples = buffer.getNumSamples();
+    for (int ch = 0; ch < layout.numInputs; ++ch)
+      buffer.copyFrom(ch, 0, *source, ch, position, numSamples);
+    position = (position + numSamples) % (kSourceLength - numSamples);
+
+    processor.processBlock(buffer, midi);
+  }
+};
+
+//==============================================================================
+/** Per-thread block latencies, one cache line apart. */
+struct alignas(64) ThreadStats {
+  std::vector<float> blockUs;
+};
+
+/**
+ * The host side: numThreads threads (the caller is thread 0) that process
+ * every instance once per cycle and meet at the end of it, like a host's
+ * audio worker group. Dynamic scheduling hands out instances from a shared
+ * counter (instances move between threads); static scheduling gives thread
+ * t the instances t, t + numThreads ...
+ *
+ * Waiting threads spin (yielding) so that cycles run back to back and the
+ * measurement is not dominated by wake-up latency.
+ */
+class StressHost {
+public:
+  StressHost(std::vector<std::unique_ptr<Instance>> &instancesToRun,
+             const StressSettings &settingsToUse, int threadsToUse,
+             int maxRecordedCycles)
+      : instances(instancesToRun), settings(settingsToUse),
+        numThreads(threadsToUse), stats(size_t(threadsToUse)) {
+    for (auto &threadStats : stats)
+      threadStats.blockUs.reserve(instances.size() *
+                                  size_t(maxRecordedCycles));
+
+    for (int t = 1; t < numThreads; ++t)
+      threads.emplace_back([this, t] { workerLoop(t); });
+  }
+
+  ~StressHost() {
+    cycle.store(-1, std::memory_order_release);
+    for (auto &thread : threads)
+      thread.join();
+  }
+
+  StressHost(const StressHost &) = delete;
+  StressHost &operator=(const StressHost &) = delete;
+
+  /** Runs one host cycle and returns its wall time in microseconds. */
+  double runCycle(bool record) {
+    VT2R_TRACE_SCOPE("host cycle");
+
+    recording = record;
+    nextInstance.store(0, std::memory_order_relaxed);
+    finished.store(0, std::memory_order_relaxed);
+
+    const auto start = juce::Time::getHighResolutionTicks();
+    cycle.store(++numCycles, std::memory_order_release);
+
+    processShare(0);
+    while (finished.load(std::memory_order_acquire) != numThreads - 1)
+      std::this_thread::yield();
+
+    const auto end = juce::Time::getHighResolutionTicks();
+    return juce::Time::highResolutionTicksToSeconds(end - start) * 1.0e6;
+  }
+
+  /** Every recorded block latency, all threads. */
+  std::vector<float> collectBlockUs() const {
+    std::vector<float> all;
+    for (const auto &threadStats : stats)
+      all.insert(all.end(), threadStats.blockUs.begin(),
+                 threadStats.blockUs.end());
+    return all;
+  }
+
+private:
+  std::vector<std::unique_ptr<Instance>> &instances;
+  const StressSettings &settings;
+  const int numThreads;
+  std::vector<ThreadStats> stats;
+  std::vector<std::thread> threads;
+  int numCycles = 0;
+  bool recording = false; // written before each cycle is published
+
+  alignas(64) std::atomic<int> cycle{0}; // -1: quit
+  alignas(64) std::atomic<int> nextInstance{0};
+  alignas(64) std::atomic<int> finished{0};
+
+  void workerLoop(int thread) {
+    int seen = 0;
+    for (;;) {
+      int current;
+      while ((current = cycle.load(std::memory_order_acquire)) == seen)
+        std::this_thread::yield();
+      if (current < 0)
+        return;
+
+      seen = current;
+      processShare(thread);
+      finished.fetch_add(1, std::memory_order_release);
+    }
+  }
+
+  void processShare(int thread) {
+    auto &blockUs = stats[size_t(thread)].blockUs;
+    const int numInstances = int(instances.size());
+
+    auto processInstance = [&](int index) {
+      const auto start = juce::Time::getHighResolutionTicks();
+      instances[size_t(index)]->process(settings);
+      const auto end = juce::Time::getHighResolutionTicks();
+
+      if (recording)
+        blockUs.push_back(float(
+            juce::Time::highResolutionTicksToSeconds(end - start) * 1.0e6));
+    };
+
+    if (settings.staticSchedule) {
+      for (int i = thread; i < numInstances; i += numThreads)
+        processInstance(i);
+      return;
+    }
+
+    for (;;) {
+      const int index = nextInstance.fetch_add(1, std::memory_order_relaxed);
+      if (index >= numInstances)
+        return;
+      processInstance(index);
+    }
+  }
+};
+
+//==============================================================================
+/** Deterministic noise at -6 dBFS. */
+juce::AudioBuffer<float> makeTestSignal() {
+  juce::AudioBuffer<float> signal(2, kSourceLength);
+  juce::Random random(0x5eed);
+
+  for (int ch = 0; ch < signal.getNumChannels(); ++ch)
+    for (int i = 0; i < kSourceLength; ++i)
+      signal.setSample(ch, i, 0.5f * (2.0f * random.nextFloat() - 1.0f));
+
+  return signal;
+}
+
+std::vector<std::unique_ptr<Instance>>
+createInstances(const StressSettings &settings,
+                const juce::AudioBuffer<float> &source) {
+  std::mt19937 random(settings.seed);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  std::uniform_real_distribution<float> value(10.0f, 100.0f);
+  std::uniform_int_distribution<int> offset(0, kSourceLength -
+                                                   settings.blockSize - 1);
+
+  std::vector<std::unique_ptr<Instance>> instances;
+  for (int i = 0; i < settings.numInstances; ++i) {
+    auto instance = std::make_unique<Instance>();
+
+    // Mixed: a quarter mono, a quarter mono -> stereo, half stereo
+    const double pick = unit(random);
+    if (settings.layout == 1)
+      instance->layout = kMono;
+    else if (settings.layout == 2)
+      instance->layout = kStereo;
+    else
+      instance->layout =
+          pick < 0.25 ? kMono : (pick < 0.5 ? kMonoToStereo : kStereo);
+
+    instance->automated = unit(random) < settings.automatedShare;
+    instance->random.seed(random());
+    instance->drive = instance->driveTarget = value(random);
+    instance->mix = instance->mixTarget = value(random);
+    instance->source = &source;
+    instance->position = offset(random);
+
+    instance->prepare(settings);
+    instances.push_back(std::move(instance));
+  }
+
+  return instances;
+}
+
+/** p in [0, 1] of sorted values. */
+double percentile(const std::vector<float> &sorted, double p) {
+  if (sorted.empty())
+    return 0.0;
+  const auto index = std::min(sorted.size() - 1,
+                              size_t(p * double(sorted.size())));
+  return double(sorted[index]);
+}
+
+StressResult runStress(std::vector<std::unique_ptr<Instance>> &instances,
+                       const StressSettings &settings, int numThreads) {
+  const double cyclesPerSecond =
+      settings.sampleRate / double(settings.blockSize);
+  const int numCycles = std::max(1, int(settings.seconds * cyclesPerSecond));
+  const int numWarmUpCycles = std::max(1, int(kWarmUpSeconds *
+                                               cyclesPerSecond));
+
+  StressHost host(instances, settings, numThreads, numCycles);
+
+  for (int c = 0; c < numWarmUpCycles; ++c)
+    host.runCycle(false);
+
+  std::vector<float> cycleUs;
+  cycleUs.reserve(size_t(numCycles));
+
+  const auto start = juce::Time::getHighResolutionTicks();
+  for (int c = 0; c < numCycles; ++c)
+    cycleUs.push_back(float(host.runCycle(true)));
+  const auto end = juce::Time::getHighResolutionTicks();
+
+  StressResult result;
+  result.numThreads = numThreads;
+
+  const double wallSeconds =
+      juce::Time::highResolutionTicksToSeconds(end - start);
+  const double audioSeconds = double(instances.size()) * double(numCycles) /
+                              cyclesPerSecond;
+  result.realtimeFactor = wallSeconds > 0.0 ? audioSeconds / wallSeconds
+                                            : 0.0;
+
+  auto blockUs = host.collectBlockUs();
+  std::sort(blockUs.begin(), blockUs.end());
+  result.blockP50 = percentile(blockUs, 0.5);
+  result.blockP99 = percentile(blockUs, 0.99);
+  result.blockP999 = percentile(blockUs, 0.999);
+  result.blockMax = blockUs.empty() ? 0.0 : double(blockUs.back());
+
+  const auto budget = float(settings.budgetUs());
+  result.overBudget =
+      double(std::count_if(cycleUs.begin(), cycleUs.end(),
+                           [budget](float us) { return us > budget; })) /
+      double(numCycles);
+
+  std::sort(cycleUs.begin(), cycleUs.end());
+  result.cycleP50 = percentile(cycleUs, 0.5);
+  result.cycleP99 = percentile(cycleUs, 0.99);
+  result.cycleMax = double(cycleUs.back());
+
+  return result;
+}
+
+//==============================================================================
+void printHeader() {
+  std::printf("%7s %11s %10s %9s %9s %9s %9s %11s %11s %11s\n", "threads",
+              "x realtime", "efficiency", "p50 us", "p99 us", "p99.9 us",
+              "max us", "cycle p50", "cycle p99", "over budget");
+}
+
+void printResult(const StressResult &r) {
+  std::printf("%7d %11.1f %9.1f%% %9.2f %9.2f %9.2f %9.2f %11.1f %11.1f "
+              "%10.2f%%\n",
+              r.numThreads, r.realtimeFactor, 100.0 * r.efficiency,
+              r.blockP50, r.blockP99, r.blockP999, r.blockMax, r.cycleP50,
+              r.cycleP99, 100.0 * r.overBudget);
+  std::fflush(stdout);
+}
+
+bool writeJson(const juce::File &file, const StressSettings &settings,
+               const std::vector<StressResult> &results) {
+  juce::Array<juce::var> entries;
+
+  for (const auto &r : results) {
+    juce::DynamicObject::Ptr entry(new juce::DynamicObject());
+    entry->setProperty("threads", r.numThreads);
+    entry->setProperty("realtimeFactor", r.realtimeFactor);
+    entry->setProperty("efficiency", r.efficiency);
+    entry->setProperty("blockUsP50", r.blockP50);
+    entry->setProperty("blockUsP99", r.blockP99);
+    entry->setProperty("blockUsP999", r.blockP999);
+    entry->setProperty("blockUsMax", r.blockMax);
+    entry->setProperty("cycleUsP50", r.cycleP50);
+    entry->setProperty("cycleUsP99", r.cycleP99);
+    entry->setProperty("cycleUsMax", r.cycleMax);
+    entry->setProperty("overBudget", r.overBudget);
+    entries.add(juce::var(entry.get()));
+  }
+
+  juce::DynamicObject::Ptr root(new juce::DynamicObject());
+  root->setProperty("tool", "vt2r_stress");
+  root->setProperty("label", settings.label);
+  root->setProperty("time", juce::Time::getCurrentTime().toISO8601(true));
+  root->setProperty("cpu", juce::SystemStats::getCpuModel());
+  root->setProperty("cpus", juce::SystemStats::getNumCpus());
+  root->setProperty("os", juce::SystemStats::getOperatingSystemName());
+  root->setProperty("instances", settings.numInstances);
+  root->setProperty("sampleRate", settings.sampleRate);
+  root->setProperty("blockSize", settings.blockSize);
+  root->setProperty("seconds", settings.seconds);
+  root->setProperty("budgetUs", settings.budgetUs());
+  root->setProperty("schedule",
+                    settings.staticSchedule ? "static" : "dynamic");
+  root->setProperty("seed", int(settings.seed));
+  root->setProperty("results", entries);
+
+  return file.replaceWithText(juce::JSON::toString(juce::var(root.get())));
+}
+
+bool writeCsv(const juce::File &file, const StressSettings &settings,
+              const std::vector<StressResult> &results) {
+  juce::String csv = "label,instances,sample_rate,block_size,schedule,"
+                     "threads,realtime_factor,efficiency,block_us_p50,"
+                     "block_us_p99,block_us_p999,block_us_max,cycle_us_p50,"
+                     "cycle_us_p99,cycle_us_max,over_budget\n";
+
+  for (const auto &r : results)
+    csv << settings.label.quoted() << "," << settings.numInstances << ","
+        << settings.sampleRate << "," << settings.blockSize << ","
+        << (settings.staticSchedule ? "static" : "dynamic") << ","
+        << r.numThreads << "," << r.realtimeFactor << "," << r.efficiency
+        << "," << r.blockP50 << "," << r.blockP99 << "," << r.blockP999
+        << "," << r.blockMax << "," << r.cycleP50 << "," << r.cycleP99 << ","
+        << r.cycleMax << "," << r.overBudget << "\n";
+
+  return file.replaceWithText(csv);
+}
+
+} // namespace
+
+//==============================================================================
+int main(int argc, char *argv[]) {
+  juce::ScopedJuceInitialiser_GUI juceInitialiser;
+  juce::ArgumentList args(argc, argv);
+
+  if (args.containsOption("-h|--help")) {
+    std::fputs(kUsage, stdout);
+    std::fputs(VT2RTools::ProcessingOptions::kUsage, stdout);
+    return 0;
+  }
+
+  auto fail = [](const juce::String &message) {
+    std::fprintf(stderr, "vt2r_stress: %s\n", message.toRawUTF8());
+    return 1;
+  };
+
+  StressSettings settings;
+  juce::String error;
+  juce::String jsonPath, csvPath;
+  const int numCpus = juce::SystemStats::getNumCpus();
+
+  if (args.containsOption("--instances"))
+    settings.numInstances =
+        args.removeValueForOption("--instances").getIntValue();
+  if (settings.numInstances < 1)
+    return fail("--instances must be at least 1");
+
+  if (args.containsOption("--threads")) {
+    for (const auto &token : juce::StringArray::fromTokens(
+             args.removeValueForOption("--threads"), ",", "")) {
+      const int count = token.trim().getIntValue();
+      if (count < 1)
+        return fail("--threads must be a list of counts of at least 1");
+      settings.threadCounts.push_back(count);
+    }
+  } else {
+    for (int count = 1; count < numCpus; count *= 2)
+      settings.threadCounts.push_back(count);
+    settings.threadCounts.push_back(numCpus);
+  }
+
+  if (args.containsOption("--block"))
+    settings.blockSize = args.removeValueForOption("--block").getIntValue();
+  if (settings.blockSize < 1 || settings.blockSize > kSourceLength / 2)
+    return fail("--block must be between 1 and " +
+                juce::String(kSourceLength / 2));
+
+  if (args.containsOption("--rate"))
+    settings.sampleRate = args.removeValueForOption("--rate").getDoubleValue();
+  if (settings.sampleRate < 8000.0)
+    return fail("--rate must be at least 8000");
+
+  if (args.containsOption("--seconds"))
+    settings.seconds = args.removeValueForOption("--seconds").getDoubleValue();
+  if (settings.seconds <= 0.0)
+    return fail("--seconds must be positive");
+
+  if (args.containsOption("--layout") &&
+      !VT2RTools::parseChoice(args.removeValueForOption("--layout"),
+                              {"mixed", "mono", "stereo"}, settings.layout))
+    return fail("--layout must be mixed, mono or stereo");
+
+  if (args.containsOption("--automated"))
+    settings.automatedShare =
+        args.removeValueForOption("--automated").getDoubleValue();
+  if (settings.automatedShare < 0.0 || settings.automatedShare > 1.0)
+    return fail("--automated must be between 0 and 1");
+
+  int schedule = 0;
+  if (args.containsOption("--schedule") &&
+      !VT2RTools::parseChoice(args.removeValueForOption("--schedule"),
+                              {"dynamic", "static"}, schedule))
+    return fail("--schedule must be dynamic or static");
+  settings.staticSchedule = schedule == 1;
+
+  if (args.containsOption("--seed"))
+    settings.seed =
+        juce::uint32(args.removeValueForOption("--seed").getLargeIntValue());
+
+  if (args.containsOption("--label"))
+    settings.label = args.removeValueForOption("--label");
+  if (args.containsOption("--json"))
+    jsonPath = args.removeValueForOption("--json");
+  if (args.containsOption("--csv"))
+    csvPath = args.removeValueForOption("--csv");
+
+  if (!settings.processing.parse(args, error))
+    return fail(error);
+
+  if (args.size() > 0)
+    return fail("unexpected argument " + args.arguments.getReference(0).text);
+
+  // --- Session ---
+  const auto source = makeTestSignal();
+  auto instances = createInstances(settings, source);
+
+  int numMono = 0, numMonoToStereo = 0, numAutomated = 0;
+  for (const auto &instance : instances) {
+    numMono += instance->layout.numOutputs == 1 ? 1 : 0;
+    numMonoToStereo += instance->layout.numInputs == 1 &&
+                               instance->layout.numOutputs == 2
+                           ? 1
+                           : 0;
+    numAutomated += instance->automated ? 1 : 0;
+  }
+
+  std::printf("%d instances (%d mono, %d mono>stereo, %d stereo; %d "
+              "automated), %.0f Hz, block %d, %s schedule\n",
+              settings.numInstances, numMono, numMonoToStereo,
+              settings.numInstances - numMono - numMonoToStereo, numAutomated,
+              settings.sampleRate, settings.blockSize,
+              settings.staticSchedule ? "static" : "dynamic");
+  std::printf("cycle budget %.1f us, %d CPUs (%s)\n\n", settings.budgetUs(),
+              numCpus, juce::SystemStats::getCpuModel().toRawUTF8());
+
+  // --- Thread counts ---
+  std::vector<StressResult> results;
+  printHeader();
+
+  for (int numThreads : settings.threadCounts) {
+    results.push_back(runStress(instances, settings, numThreads));
+
+    // Per-thread throughput relative to the first run (ideally 100%)
+    const auto &first = results.front();
+    auto &r = results.back();
+    r.efficiency = first.realtimeFactor > 0.0
+                       ? (r.realtimeFactor / double(r.numThreads)) /
+                             (first.realtimeFactor / double(first.numThreads))
+                       : 0.0;
+    printResult(r);
+  }
+
+  if (*std::max_element(settings.threadCounts.begin(),
+                        settings.threadCounts.end()) > numCpus)
+    std::printf("\nnote: more threads than CPUs; the waiting threads spin, so "
+                "those runs measure oversubscription\n");
+
+  for (auto &instance : instances)
+    instance->processor.releaseResources();
+  VT2RTrace::flush();
+
+  // --- Machine-readable output ---
+  const auto cwd = juce::File::getCurrentWorkingDirectory();
+
+  if (jsonPath.isNotEmpty() &&
+      !writeJson(cwd.getChildFile(jsonPath), settings, results))
+    return fail("cannot write JSON");
+
+  if (csvPath.isNotEmpty() &&
+      !writeCsv(cwd.getChildFile(csvPath), settings, results))
+    return fail("cannot write CSV");
+
+  return 0;
+}